@@ -0,0 +1,141 @@
+/*! @file
+    @brief This file contains hardware specific information and configuration.
+
+    USBDM_Host - Host-native build of the protocol core \n
+    The command processing code is compiled for the development host and the
+    pin-level drivers are replaced by the in-memory target models in Host/. \n
+    Supports HCS08, Coldfire V2, V3 & V4, JTAG, ARM-JTAG and ARM-SWD targets \n
+
+    @note This is not real hardware - see Host/HostHal.h for the register model.
+*/
+#ifndef _CONFIGURE_H_
+#define _CONFIGURE_H_
+
+//==========================================================================================
+// USB Serial Number
+#define SERIAL_NO          "USBDM-HOST-0001"
+#define ProductDescription "USBDM Host-native model"
+
+//==========================================================================================
+// Capabilities of the hardware - used to enable/disable appropriate code
+//
+#define HW_CAPABILITY     (CAP_VDDCONTROL|CAP_VDDSENSE|CAP_JTAG_HW|CAP_BDM|CAP_RST_IO|CAP_CFVx_HW|CAP_SWD_HW)
+#define TARGET_CAPABILITY (CAP_VDDCONTROL|CAP_VDDSENSE|CAP_HCS08|CAP_RST|CAP_CFVx|CAP_JTAG|CAP_ARM_JTAG|CAP_ARM_SWD)
+
+#ifndef PLATFORM
+#define PLATFORM USBDM   //! Choose BDM emulation
+#endif
+
+#define CPU  JMxx        //! Timer constants are those of the JMxx (24 MHz bus)
+
+//=================================================================================
+// Debug pin - used to check timing and hardware sequences etc.
+//
+#if (DEBUG != 0)
+#define DEBUG_PIN_DDR PTGDD_PTGDD2
+#define DEBUG_PIN_PER PTGPE_PTGPE2
+#define DEBUG_PIN     PTGD_PTGD2
+#endif
+
+//=================================================================================
+// Direct pin control (CMD_USBDM_CONTROL_PINS)
+//   The target models work at the BDM_CMD_xx()/swd_xx()/jtag_xx() level so these
+//   pins only record the requested state.
+//   Changes to BKPT & RESET are passed to the models (halPinsChanged())
+//   as they halt or reset the target.
+//
+#define BDM_OUT           PTED_PTED7
+#define BDM_OUT_DDR       PTEDD_PTEDD7
+#define BDM_LOW()         (BDM_OUT=0,BDM_OUT_DDR=1)
+#define BDM_HIGH()        (BDM_OUT=1,BDM_OUT_DDR=1)
+#define BDM_3STATE()      (BDM_OUT=1,BDM_OUT_DDR=0)
+
+#define TRST_OUT          PTED_PTED3
+#define TRST_OUT_DDR      PTEDD_PTEDD3
+#define TRST_LOW()        (TRST_OUT=0,TRST_OUT_DDR=1)
+#define TRST_3STATE()     (TRST_OUT=1,TRST_OUT_DDR=0)
+
+#define TA_OUT            PTFD_PTFD4
+#define TA_OUT_DDR        PTFDD_PTFDD4
+#define TA_LOW()          (TA_OUT=0,TA_OUT_DDR=1)
+#define TA_3STATE()       (TA_OUT=1,TA_OUT_DDR=0)
+
+#define BKPT_OUT          PTBD_PTBD0
+#define BKPT_OUT_DDR      PTBDD_PTBDD0
+#define BKPT_LOW()        (BKPT_OUT=0,BKPT_OUT_DDR=1,halPinsChanged())
+#define BKPT_HIGH()       (BKPT_OUT=1,BKPT_OUT_DDR=1,halPinsChanged())
+
+#define SWD_OUT           PTAD_PTAD2
+#define SWD_OUT_DDR       PTADD_PTADD2
+#define SWD_LOW()         (SWD_OUT=0,SWD_OUT_DDR=1)
+#define SWD_HIGH()        (SWD_OUT=1,SWD_OUT_DDR=1)
+#define SWD_3STATE()      (SWD_OUT=1,SWD_OUT_DDR=0)
+
+//=================================================================================
+// RESET control & sensing
+//
+#if (HW_CAPABILITY&CAP_RST_IO)
+
+// RESET output pin
+#define RESET_OUT           PTCD_PTCD4
+#define RESET_OUT_DDR       PTCDD_PTCDD4
+#define RESET_LOW()         (RESET_OUT=0,RESET_OUT_DDR=1,halPinsChanged())
+#define RESET_3STATE()      (RESET_OUT=1,RESET_OUT_DDR=0,halPinsChanged())
+
+// RESET input pin - looped back from the RESET output (the models never hold reset)
+#define RESET_IN            PTCD_PTCD4
+#define RESET_IN_NUM        (4)
+#define RESET_IN_MASK       (1<<RESET_IN_NUM)
+
+#define RESET_IS_HIGH       (RESET_IN!=0)
+#define RESET_IS_LOW        (RESET_IN==0)
+
+#endif // CAP_RST_IO
+
+//=================================================================================
+// LED Port bit masks
+//
+#define GREEN_LED_MASK  (PTGD_PTGD0_MASK)
+#define RED_LED_MASK    (PTGD_PTGD1_MASK)
+#define LED_PORT_DATA   (PTGD)
+#define LED_PORT_DDR    (PTGDD)
+
+#define LED_INIT()         ((LED_PORT_DATA |= RED_LED_MASK|GREEN_LED_MASK), \
+                            (LED_PORT_DDR  |= RED_LED_MASK|GREEN_LED_MASK))
+#define GREEN_LED_ON()     (LED_PORT_DATA &= (GREEN_LED_MASK^0xFF))
+#define GREEN_LED_OFF()    (LED_PORT_DATA |= GREEN_LED_MASK)
+#define GREEN_LED_TOGGLE() (LED_PORT_DATA ^= GREEN_LED_MASK)
+#define RED_LED_ON()       (LED_PORT_DATA &= (RED_LED_MASK^0xFF))
+#define RED_LED_OFF()      (LED_PORT_DATA |= RED_LED_MASK)
+#define RED_LED_TOGGLE()   (LED_PORT_DATA ^= RED_LED_MASK)
+
+//=================================================================================
+// Flash programming control
+//
+#define FLASH12V_ON()   ; //!
+#define FLASH12V_OFF()  ; //!
+
+#define VPP_ON()        ; //!
+#define VPP_OFF()       ; //!
+
+//=================================================================================
+// Target Vdd control - the target models are always powered
+//
+#define VDD_OFF()        ; // Vdd Off
+#define VDD3_ON()        ; // Vdd = 3.3V
+#define VDD5_ON()        ; // Vdd = 5V
+
+//================================================================================
+// Timer Channel use
+//   TPMx = TPM1 - the counter is advanced by the target models (see halTimerAdvance())
+//
+#define TPMSC              TPM1SC
+#define TPMCNT             TPM1CNT
+#define TPMSC_CLKSA_MASK   TPM1SC_CLKSA_MASK
+
+//===================================================================================
+// Target Vdd sensing
+//
+#define VDD_SENSE                 (1) // Target models are always powered
+
+#endif // _CONFIGURE_H_
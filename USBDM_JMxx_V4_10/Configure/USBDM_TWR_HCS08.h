@@ -1,29 +1,29 @@
-/*! @file
-    @brief This file contains hardware specific information and configuration.
-    
-    USBDM_TWR_HCS08 - USDBM for RS08/HCS08 TWR boards
-            
-    @note DO NOT CHANGE THIS FILE \n
-    If you need to create another configuration make a copy of this file
-    under a new name and change Configure.h appropriately.
-*/
-#ifndef _CONFIGURE_H_
-#define _CONFIGURE_H_
-
-//==========================================================================================
-// USB Serial Number
-#define SERIAL_NO          "USBDM-TWR-HCS08-0001"
-#define ProductDescription "USBDM RS08,HCS08 BDM for Tower"
-
-//==========================================================================================
-// Capabilities of the hardware - used to enable/disable appropriate code
-//
-#define HW_CAPABILITY     (CAP_VDDCONTROL|CAP_VDDSENSE|CAP_CDC|CAP_BDM|CAP_FLASH)
-#define TARGET_CAPABILITY (CAP_VDDCONTROL|CAP_VDDSENSE|CAP_CDC|CAP_RS08|CAP_HCS08)
-
-// Include common pin assignments
-#include "USBDM_TWR.h"
-
-#define  VDD_HAS_DIVIDER     2 // VDD input has 2:1 voltage divider
-
-#endif // _CONFIGURE_H_
+/*! @file
+    @brief This file contains hardware specific information and configuration.
+    
+    USBDM_TWR_HCS08 - USDBM for RS08/HCS08 TWR boards
+            
+    @note DO NOT CHANGE THIS FILE \n
+    If you need to create another configuration make a copy of this file
+    under a new name and change Configure.h appropriately.
+*/
+#ifndef _CONFIGURE_H_
+#define _CONFIGURE_H_
+
+//==========================================================================================
+// USB Serial Number
+#define SERIAL_NO          "USBDM-TWR-HCS08-0001"
+#define ProductDescription "USBDM RS08,HCS08 BDM for Tower"
+
+//==========================================================================================
+// Capabilities of the hardware - used to enable/disable appropriate code
+//
+#define HW_CAPABILITY     (CAP_VDDCONTROL|CAP_VDDSENSE|CAP_CDC|CAP_BDM|CAP_FLASH)
+#define TARGET_CAPABILITY (CAP_VDDCONTROL|CAP_VDDSENSE|CAP_CDC|CAP_RS08|CAP_HCS08)
+
+// Include common pin assignments
+#include "USBDM_TWR.h"
+
+#define  VDD_HAS_DIVIDER     2 // VDD input has 2:1 voltage divider
+
+#endif // _CONFIGURE_H_
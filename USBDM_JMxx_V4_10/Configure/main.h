@@ -1,7 +1,7 @@
-#ifndef _MAIN_H_
-#define _MAIN_H_
-
-#pragma DATA_SEG __SHORT_SEG Z_PAGE
-#pragma DATA_SEG DEFAULT
-
-#endif
+#ifndef _MAIN_H_
+#define _MAIN_H_
+
+#pragma DATA_SEG __SHORT_SEG Z_PAGE
+#pragma DATA_SEG DEFAULT
+
+#endif
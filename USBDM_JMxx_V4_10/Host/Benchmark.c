@@ -0,0 +1,364 @@
+/*! \file
+    \brief Command stream benchmark for the host-native build.
+
+    Replays files of BDM commands through commandLoop() against the in-memory
+    target models and reports:
+    - commands/s   - host (wall clock) throughput of the protocol core
+    - bits/cmd     - bits clocked on the debug interface per command
+    - xfers/cmd    - interface transactions per command (BDM commands, CF packets,
+                     SWD/JTAG-DP accesses or JTAG scans)
+    - us/cmd       - modelled time on the debug interface per command
+    - failures     - commands that did not return BDM_RC_OK
+
+    Usage: usbdm-bench [-n passes] [-v] file.cmd ...
+    - -v prints the responses of the first pass
+
+    Stream file format - one command per line:
+    \verbatim
+       [count*] command [parameter ...]   # comment
+    \endverbatim
+    - count     - optional repeat count for the line
+    - command   - CMD_USBDM_xx name (the CMD_USBDM_ prefix may be omitted) or number
+    - parameter - XX        hex byte (0x prefix optional)
+                  n*XX      n copies of byte XX
+                  w:XXXX    16-bit value in host byte order (as *(U16*) in the firmware)
+                  l:XXXXXXXX 32-bit value in host byte order (as *(U32*) in the firmware)
+
+    The parameters follow the command byte i.e. the first is commandBuffer[2].
+
+    Each pass starts from the power-on state of the BDM & target models.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <time.h>
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDM.h"
+#include "CmdProcessing.h"
+#include "BDMCommon.h"
+#include "HostModel.h"
+#include "HostUSB.h"
+
+#define DEFAULT_PASSES   (1000)
+#define MAX_LINE_LENGTH  (2000)
+
+//! Command names
+static const struct {
+   const char *name;
+   U8          command;
+} commandNames[] = {
+   {"GET_COMMAND_RESPONSE",  CMD_USBDM_GET_COMMAND_RESPONSE},
+   {"SET_TARGET",            CMD_USBDM_SET_TARGET},
+   {"SET_VDD",               CMD_USBDM_SET_VDD},
+   {"DEBUG",                 CMD_USBDM_DEBUG},
+   {"GET_BDM_STATUS",        CMD_USBDM_GET_BDM_STATUS},
+   {"GET_CAPABILITIES",      CMD_USBDM_GET_CAPABILITIES},
+   {"SET_OPTIONS",           CMD_USBDM_SET_OPTIONS},
+   {"CONTROL_PINS",          CMD_USBDM_CONTROL_PINS},
+   {"GET_VER",               CMD_USBDM_GET_VER},
+   {"CONNECT",               CMD_USBDM_CONNECT},
+   {"SET_SPEED",             CMD_USBDM_SET_SPEED},
+   {"GET_SPEED",             CMD_USBDM_GET_SPEED},
+   {"CONTROL_INTERFACE",     CMD_USBDM_CONTROL_INTERFACE},
+   {"READ_STATUS_REG",       CMD_USBDM_READ_STATUS_REG},
+   {"WRITE_CONTROL_REG",     CMD_USBDM_WRITE_CONTROL_REG},
+   {"TARGET_RESET",          CMD_USBDM_TARGET_RESET},
+   {"TARGET_STEP",           CMD_USBDM_TARGET_STEP},
+   {"TARGET_GO",             CMD_USBDM_TARGET_GO},
+   {"TARGET_HALT",           CMD_USBDM_TARGET_HALT},
+   {"WRITE_REG",             CMD_USBDM_WRITE_REG},
+   {"READ_REG",              CMD_USBDM_READ_REG},
+   {"WRITE_CREG",            CMD_USBDM_WRITE_CREG},
+   {"READ_CREG",             CMD_USBDM_READ_CREG},
+   {"WRITE_DREG",            CMD_USBDM_WRITE_DREG},
+   {"READ_DREG",             CMD_USBDM_READ_DREG},
+   {"WRITE_MEM",             CMD_USBDM_WRITE_MEM},
+   {"READ_MEM",              CMD_USBDM_READ_MEM},
+   {"JTAG_GOTORESET",        CMD_USBDM_JTAG_GOTORESET},
+   {"JTAG_GOTOSHIFT",        CMD_USBDM_JTAG_GOTOSHIFT},
+   {"JTAG_WRITE",            CMD_USBDM_JTAG_WRITE},
+   {"JTAG_READ",             CMD_USBDM_JTAG_READ},
+   {"SET_VPP",               CMD_USBDM_SET_VPP},
+   {"JTAG_READ_WRITE",       CMD_USBDM_JTAG_READ_WRITE},
+   {"JTAG_EXECUTE_SEQUENCE", CMD_USBDM_JTAG_EXECUTE_SEQUENCE},
+   {"READ_MEM_STREAM",       CMD_USBDM_READ_MEM_STREAM},
+   {"EXECUTE_BATCH",         CMD_USBDM_EXECUTE_BATCH},
+   {"CRC_MEM",               CMD_USBDM_CRC_MEM},
+   {"FILL_MEM",              CMD_USBDM_FILL_MEM},
+   {"VERIFY_MEM",            CMD_USBDM_VERIFY_MEM},
+   {"READ_MEM_GATHER",       CMD_USBDM_READ_MEM_GATHER},
+   {"POLL_MEM",              CMD_USBDM_POLL_MEM},
+   {"MODIFY_MEM",            CMD_USBDM_MODIFY_MEM},
+   {"HASH_MEM",              CMD_USBDM_HASH_MEM},
+   {"READ_MEM_RLE",          CMD_USBDM_READ_MEM_RLE},
+   {"WRITE_MEM_RLE",         CMD_USBDM_WRITE_MEM_RLE},
+   {"SET_READ_CACHE",        CMD_USBDM_SET_READ_CACHE},
+};
+
+//! Encoded command records of a stream file
+typedef struct {
+   U8       *records;  //!< Command records ([0] = size, [1] = command, [2..] = parameters)
+   uint32_t  length;   //!< Size of records
+   uint32_t  size;     //!< Allocated size
+   uint32_t  count;    //!< Number of commands
+} Stream_t;
+
+//! Report an error in a stream file and exit
+//!
+static void streamError(const char *fileName, unsigned lineNum, const char *message, const char *token) {
+   fprintf(stderr, "%s:%u: %s '%s'\n", fileName, lineNum, message, token);
+   exit(EXIT_FAILURE);
+}
+
+//! Parse a hex number
+//!
+//! @return TRUE if the whole token is a valid number <= maxValue
+//!
+static int parseHex(const char *token, unsigned long maxValue, unsigned long *value) {
+char *end;
+
+   if (!isxdigit((unsigned char)*token))
+      return FALSE;
+   *value = strtoul(token, &end, 16);
+   return (*end == '\0') && (*value <= maxValue);
+}
+
+//! Find a command by name or number
+//!
+static int parseCommand(const char *token, U8 *command) {
+unsigned      index;
+unsigned long value;
+char         *end;
+
+   if (strncmp(token, "CMD_USBDM_", 10) == 0)
+      token += 10;
+   for (index=0; index<sizeof(commandNames)/sizeof(commandNames[0]); index++) {
+      if (strcmp(token, commandNames[index].name) == 0) {
+         *command = commandNames[index].command;
+         return TRUE;
+      }
+   }
+   value = strtoul(token, &end, 0);
+   if ((*end != '\0') || (end == token) || (value > 0x7F))
+      return FALSE;
+   *command = (U8)value;
+   return TRUE;
+}
+
+//! Encode one line of a stream file as a command record
+//!
+//! @param buffer - buffer for record (MAX_COMMAND_SIZE bytes)
+//!
+//! @return size of record, 0 if the line is empty
+//!
+static U8 parseLine(const char *fileName, unsigned lineNum, char *line, U8 *buffer, unsigned *repeat) {
+char          *token;
+char          *star;
+unsigned long  value;
+unsigned long  count;
+U16            word;
+U32            longword;
+U8             size = 2;
+
+   *repeat = 1;
+   if ((token = strchr(line, '#')) != NULL)
+      *token = '\0';
+   token = strtok(line, " \t\r\n");
+   if (token == NULL)
+      return 0;
+   count = strtoul(token, &star, 10);
+   if ((star != token) && (*star == '*') && (star[1] == '\0')) {
+      if (count == 0)
+         streamError(fileName, lineNum, "Illegal repeat count", token);
+      *repeat = (unsigned)count;
+      token = strtok(NULL, " \t\r\n");
+      if (token == NULL)
+         streamError(fileName, lineNum, "Missing command", "");
+   }
+   if (!parseCommand(token, buffer+1))
+      streamError(fileName, lineNum, "Unknown command", token);
+
+   while ((token = strtok(NULL, " \t\r\n")) != NULL) {
+      if (strncmp(token, "w:", 2) == 0) {
+         if (!parseHex(token+2, 0xFFFF, &value) || (size+sizeof(word) > MAX_COMMAND_SIZE))
+            streamError(fileName, lineNum, "Illegal parameter", token);
+         word = (U16)value;
+         (void)memcpy(buffer+size, &word, sizeof(word));
+         size += sizeof(word);
+         continue;
+      }
+      if (strncmp(token, "l:", 2) == 0) {
+         if (!parseHex(token+2, 0xFFFFFFFFUL, &value) || (size+sizeof(longword) > MAX_COMMAND_SIZE))
+            streamError(fileName, lineNum, "Illegal parameter", token);
+         longword = (U32)value;
+         (void)memcpy(buffer+size, &longword, sizeof(longword));
+         size += sizeof(longword);
+         continue;
+      }
+      count = 1;
+      star  = strchr(token, '*');
+      if (star != NULL) {
+         count = strtoul(token, NULL, 10);
+         token = star+1;
+      }
+      if (strncmp(token, "0x", 2) == 0)
+         token += 2;
+      if (!parseHex(token, 0xFF, &value) || (count == 0) || (size+count > MAX_COMMAND_SIZE))
+         streamError(fileName, lineNum, "Illegal parameter", token);
+      (void)memset(buffer+size, (int)value, count);
+      size += (U8)count;
+   }
+   buffer[0] = size;
+   return size;
+}
+
+//! Read & encode a stream file
+//!
+static void loadStream(const char *fileName, Stream_t *stream) {
+FILE     *fp;
+char      line[MAX_LINE_LENGTH];
+U8        record[MAX_COMMAND_SIZE];
+unsigned  lineNum = 0;
+unsigned  repeat;
+U8        size;
+
+   (void)memset(stream, 0, sizeof(*stream));
+   fp = fopen(fileName, "r");
+   if (fp == NULL) {
+      perror(fileName);
+      exit(EXIT_FAILURE);
+   }
+   while (fgets(line, sizeof(line), fp) != NULL) {
+      lineNum++;
+      size = parseLine(fileName, lineNum, line, record, &repeat);
+      if (size == 0)
+         continue;
+      while (repeat-- > 0) {
+         if (stream->length+size > stream->size) {
+            stream->size    = 2*stream->size+MAX_COMMAND_SIZE;
+            stream->records = realloc(stream->records, stream->size);
+            if (stream->records == NULL) {
+               perror("realloc");
+               exit(EXIT_FAILURE);
+            }
+         }
+         (void)memcpy(stream->records+stream->length, record, size);
+         stream->length += size;
+         stream->count++;
+      }
+   }
+   (void)fclose(fp);
+}
+
+//! Wall clock time in seconds
+//!
+static double wallTime(void) {
+struct timespec now;
+
+   (void)clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec+now.tv_nsec*1e-9;
+}
+
+//! Replay a stream & report
+//!
+static int runStream(const char *fileName, const Stream_t *stream, unsigned passes) {
+static BDM_Option_t        bdmOptionInitial;
+static CableStatus_t       cableStatusInitial;
+static int                 initialSaved = FALSE;
+jmp_buf          endOfRecords;
+HostWireStats_t  wire   = {0};
+uint64_t         ticks  = 0;
+uint64_t         failures = 0;
+uint64_t         startTicks;
+uint64_t         commands;
+double           startTime;
+double           elapsed;
+unsigned         pass;
+const char      *name = strrchr(fileName, '/');
+
+   if (!initialSaved) {
+      // Power-on values of the BDM state
+      bdmOptionInitial   = bdm_option;
+      cableStatusInitial = cable_status;
+      initialSaved       = TRUE;
+   }
+   startTime = wallTime();
+   for (pass=0; pass<passes; pass++) {
+      bdm_option   = bdmOptionInitial;
+      cable_status = cableStatusInitial;
+      hostModelReset();
+      startTicks = halTimerElapsed();
+      hostUsbStart(stream->records, stream->length, &endOfRecords);
+      if (setjmp(endOfRecords) == 0) {
+         commandLoop();
+      }
+      hostUsbTrace   = FALSE;
+      ticks          += halTimerElapsed()-startTicks;
+      wire.bits      += hostWire.bits;
+      wire.transfers += hostWire.transfers;
+      failures       += hostUsb.failures;
+      if ((pass == 0) && (hostUsb.failures != 0)) {
+         fprintf(stderr, "%s: command #%u (%u) failed, rc = %u\n",
+                 fileName, (unsigned)hostUsb.failIndex+1, hostUsb.failCommand, hostUsb.failStatus);
+      }
+   }
+   elapsed  = wallTime()-startTime;
+   commands = (uint64_t)stream->count*passes;
+   printf("%-24s %8u %12.0f %10.1f %10.2f %10.2f %8llu\n",
+          (name != NULL)?name+1:fileName, stream->count,
+          commands/elapsed,
+          (double)wire.bits/commands,
+          (double)wire.transfers/commands,
+          (double)ticks/commands/TIMER_MICROSECOND(1),
+          (unsigned long long)failures);
+   return failures == 0;
+}
+
+int main(int argc, char *argv[]) {
+unsigned  passes = DEFAULT_PASSES;
+int       argNum = 1;
+int       success = TRUE;
+U8        verbose = FALSE;
+Stream_t  stream;
+
+   for (; (argNum < argc) && (argv[argNum][0] == '-'); argNum++) {
+      if ((strcmp(argv[argNum], "-n") == 0) && (argNum+1 < argc)) {
+         passes = (unsigned)strtoul(argv[++argNum], NULL, 10);
+      }
+      else if (strcmp(argv[argNum], "-v") == 0) {
+         verbose = TRUE;
+      }
+      else {
+         passes = 0;
+         break;
+      }
+   }
+   if ((argNum >= argc) || (passes == 0)) {
+      fprintf(stderr, "Usage: %s [-n passes] [-v] file.cmd ...\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   printf("%-24s %8s %12s %10s %10s %10s %8s\n",
+          "stream", "commands", "commands/s", "bits/cmd", "xfers/cmd", "us/cmd", "failures");
+   for (; argNum<argc; argNum++) {
+      loadStream(argv[argNum], &stream);
+      if (stream.count == 0) {
+         fprintf(stderr, "%s: no commands\n", argv[argNum]);
+         success = FALSE;
+         continue;
+      }
+      hostUsbTrace = verbose;
+      if (!runStream(argv[argNum], &stream, passes))
+         success = FALSE;
+      free(stream.records);
+   }
+   return success?EXIT_SUCCESS:EXIT_FAILURE;
+}
@@ -0,0 +1,799 @@
+/*! \file
+    \brief Host-native replacement for BDM.c - HCS08 target model
+
+    Models an HCS08 Background Debug Controller at the level of the
+    BDM_CMD_xx() routines.  The BDM sequences above that level (connect,
+    ACKN enable, BDM enable & reset) follow BDM.c.
+
+    An HC12 without SYNC support may be selected by hostHc12Target() to
+    exercise bdmHC12_alt_speed_detect() (BDM_HC12.c).  It only responds to
+    commands sent at its own speed.
+
+    Wire cost of each command:
+    - 8 bits for the command byte and each byte sent or received,
+      each bit being 16 BDC clock cycles.
+    - ACKN mode : the ACKN pulse (1 bit time) or the ACKN timeout.
+    - WAIT mode : 64 or 150 BDC cycles as calculated by bdm_RxTxSelect().
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "TargetDefines.h"
+#include "BDM.h"
+#include "BDMMacros.h"
+#include "BDMCommon.h"
+#include "CmdProcessing.h"
+#include "HostModel.h"
+
+#define BDM_SYNC_REQus          960U //!< us - length of the longest possible SYNC REQUEST pulse
+#define SYNC_TIMEOUTus          460U //!< us - longest time for the target to completed a SYNC pulse
+#define ACKN_TIMEOUTus          375U //!< us - longest time after which the target should produce ACKN pulse
+#define RESET_LENGTHms          100U //!< ms - time of RESET assertion
+
+//! Shortest wait in timer ticks - allows ~16 bus cycles for setting up the timer
+#define WAIT_MIN_TICKS ((U16)((16*(TIMER_FREQ/1000UL))/(BUS_FREQ/1000UL))+1)
+
+//! BDC clock of the modelled target (kHz)
+#define HCS08_BDC_CLOCK_kHz     (8000U)
+
+//! Length of a BDM bit (16 BDC cycles) in timer ticks
+#define HCS08_BIT_TICKS         ((U16)((16*(TIMER_FREQ/1000UL))/HCS08_BDC_CLOCK_kHz))
+
+//! Wait after the command/parameters
+typedef enum {
+   WAIT_NONE = 0,  //!< No ACKN/WAIT (NOACK commands)
+   WAIT_64   = 1,  //!< ACKN or 64 BDC cycles
+   WAIT_150  = 2,  //!< ACKN or 150 BDC cycles
+} BdmWait_t;
+
+//! State of the modelled HCS08
+static struct {
+   U8  bdcscr;        //!< BDCSCR control bits (ENBDM, BKPTEN, FTS, CLKSW)
+   U8  halted;        //!< Target is in active background mode (BDMACT)
+   U8  acknEnabled;   //!< ACKN pulses enabled (ACK_ENABLE)
+   U8  resetPending;  //!< SBDFR.BDFR written - target held in reset
+   U8  a;             //!< A register
+   U8  ccr;           //!< CCR register
+   U16 hx;            //!< HX register
+   U16 sp;            //!< SP register
+   U16 pc;            //!< PC register
+   U16 bkpt;          //!< BDC breakpoint register
+} hcs08;
+
+//! State of the modelled HC12 (no SYNC) - see hostHc12Target()
+static struct {
+   U16 syncLength;    //!< SYNC length the target responds to (60MHz ticks), 0 => not selected
+   U8  bdmccr;        //!< BDM CCR save register
+} hc12;
+
+U16      hostHc12SpeedsTried[HOST_HC12_MAX_TRIED];
+unsigned hostHc12NumTried;
+
+U8   (*bdm_rx_ptr)(void)      = bdm_rxEmpty;      //!< pointers to current bdm_Rx routine
+void (*bdm_tx_ptr)(U8)        = bdm_txEmpty;      //!< pointers to current bdm_Tx routine
+void (*bdm_txBlock_ptr)(void) = bdm_txBlockEmpty; //!< pointers to current bdm_Tx..Block routine
+
+//! Dummy routines used when the interface speed is unknown
+//!
+void bdm_txEmpty(U8 data) {
+   (void)data;
+}
+void bdm_txBlockEmpty(void) {
+}
+U8 bdm_rxEmpty( void ) {
+   return 0;
+}
+
+//! Model Tx/Rx routines - selected by bdm_RxTxSelect()
+//!
+//! @note The model works at the BDM_CMD_xx() level so these are
+//!       only used to indicate a speed has been established.
+//!
+static void bdm_txModel(U8 data) {
+   hostWireCharge(8, HCS08_BIT_TICKS);
+   (void)data;
+}
+static void bdm_txModelBlock(void) {
+}
+static U8 bdm_rxModel(void) {
+   hostWireCharge(8, HCS08_BIT_TICKS);
+   return 0xFF;
+}
+
+//=========================================================================
+// Target model
+//
+//=========================================================================
+
+//! Reset the modelled HCS08
+//!
+//! @param mode
+//!    - \ref RESET_SPECIAL => Reset to special mode (BDM active, target halted)
+//!    - \ref RESET_NORMAL  => Reset to normal mode (target executes)
+//!
+void hostHcs08Reset(U8 mode) {
+   hcs08.bdcscr       = HC08_BDCSCR_CLKSW;
+   hcs08.halted       = FALSE;
+   hcs08.acknEnabled  = FALSE;
+   hcs08.resetPending = FALSE;
+   hcs08.a            = 0;
+   hcs08.ccr          = 0x68;
+   hcs08.hx           = 0;
+   hcs08.sp           = 0x00FF;
+   hcs08.pc           = (HOST_MEM(0xFFFE)<<8)|HOST_MEM(0xFFFF);
+   hcs08.bkpt         = 0;
+   if ((mode&RESET_MODE_MASK) == RESET_SPECIAL) {
+      hcs08.bdcscr |= HC08_BDCSCR_ENBDM;
+      hcs08.halted  = TRUE;
+   }
+}
+
+//! Halt the modelled HCS08 as if it had hit a breakpoint
+//!
+void hostHcs08Halt(void) {
+   hcs08.halted = TRUE;
+}
+
+//! Complete a reset requested through SBDFR
+//!
+//! BKGD is sampled as the target leaves reset (low => special mode)
+//!
+static void hcs08ResetRelease(void) {
+   if (hcs08.resetPending) {
+      hostHcs08Reset(((BDM_OUT_DDR != 0) && (BDM_OUT == 0))?RESET_SPECIAL:RESET_NORMAL);
+   }
+}
+
+//! Select the modelled HC12
+//!
+//! The HC12 has no SYNC so its speed must be found by trial and error.
+//!
+//! @param busFrequency - target bus frequency in Hz (0 => no HC12 model)
+//! @param partid       - value of the PARTID register
+//!
+void hostHc12Target(U32 busFrequency, U16 partid) {
+   hc12.syncLength = (busFrequency == 0)?0:SYNC_MULTIPLE(busFrequency);
+   hc12.bdmccr     = 0;
+   HOST_MEM(HCS12_PARTID)   = (U8)(partid>>8);
+   HOST_MEM(HCS12_PARTID+1) = (U8)partid;
+   hostHc12NumTried = 0;
+}
+
+//! Execute a BDM command on the modelled HC12
+//!
+//! Only commands sent within 3% of the target's speed are understood
+//!
+//! @return TRUE  => command executed \n
+//!         FALSE => command ignored by target
+//!
+static U8 hc12Execute(U8 cmd, U16 addr, U16 value, U16 *result) {
+U16 error;
+
+   // Record each new speed tried
+   if ((hostHc12NumTried == 0) ||
+       (hostHc12SpeedsTried[hostHc12NumTried-1] != cable_status.sync_length)) {
+      if (hostHc12NumTried < HOST_HC12_MAX_TRIED)
+         hostHc12SpeedsTried[hostHc12NumTried++] = cable_status.sync_length;
+   }
+   if (hc12.syncLength == 0)
+      return FALSE;
+   error = (cable_status.sync_length > hc12.syncLength)?
+             cable_status.sync_length-hc12.syncLength:hc12.syncLength-cable_status.sync_length;
+   if (error > hc12.syncLength/32)
+      return FALSE;
+
+   switch (cmd) {
+      case _BDM12_READ_WORD:
+         *result = (HOST_MEM(addr)<<8)|HOST_MEM(addr+1);
+         return TRUE;
+      case _BDM12_WRITE_WORD:
+         HOST_MEM(addr)   = (U8)(value>>8);
+         HOST_MEM(addr+1) = (U8)value;
+         return TRUE;
+      case _BDM12_READ_BD_BYTE:
+         *result = (addr == HC12_BDMCCR)?(hc12.bdmccr<<8)|hc12.bdmccr:0xFFFF;
+         return TRUE;
+      case _BDM12_WRITE_BD_BYTE:
+         if (addr == HC12_BDMCCR)
+            hc12.bdmccr = (U8)value;
+         return TRUE;
+      default:
+         return FALSE;
+   }
+}
+
+//! BDCSCR as read by READ_STATUS
+//!
+static U8 hcs08Status(void) {
+   return hcs08.bdcscr|(hcs08.halted?HC08_BDCSCR_BDMACT:0);
+}
+
+//! Write to target memory - SBDFR.BDFR resets the target
+//!
+static void hcs08WriteByte(U16 addr, U8 value) {
+   if ((addr == HCS08_SBDFR) && (value & HCS_SBDFR_BDFR)) {
+      hcs08.resetPending = TRUE;
+      hcs08.halted       = FALSE;
+      return;
+   }
+   HOST_MEM(addr) = value;
+}
+
+//! Execute a BDM command on the modelled HCS08
+//!
+//! @param cmd     - BDM command
+//! @param addr    - address parameter (if any)
+//! @param value   - data parameter (if any)
+//! @param result  - response (unchanged if command is not executed)
+//!
+//! @return TRUE  => command executed (target would produce ACKN) \n
+//!         FALSE => command ignored by target
+//!
+static U8 hcs08Execute(U8 cmd, U16 addr, U16 value, U16 *result) {
+
+   if (hcs08.resetPending)
+      return FALSE;
+
+   // Non-intrusive commands
+   switch (cmd) {
+      case _BDM_BACKGROUND:
+         if ((hcs08.bdcscr & HC08_BDCSCR_ENBDM) == 0)
+            return FALSE;
+         hcs08.halted = TRUE;
+         return TRUE;
+      case _BDM_ACK_ENABLE:
+         hcs08.acknEnabled = TRUE;
+         return TRUE;
+      case _BDM_ACK_DISABLE:
+         hcs08.acknEnabled = FALSE;
+         return TRUE;
+      case _BDM08_READ_STATUS:
+         *result = hcs08Status();
+         return TRUE;
+      case _BDM08_WRITE_CONTROL:
+         hcs08.bdcscr = (U8)value & (HC08_BDCSCR_ENBDM|HC08_BDCSCR_BKPTEN|HC08_BDCSCR_FTS|HC08_BDCSCR_CLKSW);
+         return TRUE;
+      case _BDM_READ_BYTE:
+         *result = HOST_MEM(addr);
+         return TRUE;
+      case _BDM08_READ_BYTE_WS:
+         *result = (hcs08Status()<<8)|HOST_MEM(addr);
+         return TRUE;
+      case _BDM_WRITE_BYTE:
+         hcs08WriteByte(addr, (U8)value);
+         return TRUE;
+      case _BDM08_WRITE_BYTE_WS:
+         hcs08WriteByte(addr, (U8)value);
+         *result = hcs08Status();
+         return TRUE;
+      case _BDM08_READ_BKPT:
+         *result = hcs08.bkpt;
+         return TRUE;
+      case _BDM08_WRITE_BKPT:
+         hcs08.bkpt = value;
+         return TRUE;
+   }
+   // Active background mode commands
+   if (!hcs08.halted)
+      return FALSE;
+
+   switch (cmd) {
+      case _BDM_GO:
+      case _BDM_TAGGO:      hcs08.halted = FALSE;                  break;
+      case _BDM_TRACE1:     hcs08.pc++;                            break; // Every instruction is a NOP
+      case _BDM08_READ_A:   *result = hcs08.a;                     break;
+      case _BDM08_READ_CCR: *result = hcs08.ccr;                   break;
+      case _BDM08_READ_PC:  *result = hcs08.pc;                    break;
+      case _BDM08_READ_HX:  *result = hcs08.hx;                    break;
+      case _BDM08_READ_SP:  *result = hcs08.sp;                    break;
+      case _BDM08_READ_NEXT:
+         hcs08.hx++;
+         *result = HOST_MEM(hcs08.hx);
+         break;
+      case _BDM08_READ_NEXT_WS:
+         hcs08.hx++;
+         *result = (hcs08Status()<<8)|HOST_MEM(hcs08.hx);
+         break;
+      case _BDM08_WRITE_A:   hcs08.a   = (U8)value;                break;
+      case _BDM08_WRITE_CCR: hcs08.ccr = (U8)value;                break;
+      case _BDM08_WRITE_PC:  hcs08.pc  = value;                    break;
+      case _BDM08_WRITE_HX:  hcs08.hx  = value;                    break;
+      case _BDM08_WRITE_SP:  hcs08.sp  = value;                    break;
+      case _BDM08_WRITE_NEXT:
+         hcs08.hx++;
+         hcs08WriteByte(hcs08.hx, (U8)value);
+         break;
+      default:
+         return FALSE;
+   }
+   return TRUE;
+}
+
+//! Carry out a BDM command - charges the wire and timer
+//!
+//! @param cmd      - BDM command
+//! @param txBytes  - # of parameter bytes sent after the command
+//! @param rxBytes  - # of response bytes
+//! @param wait     - ACKN/WAIT after the parameters
+//! @param addr     - address parameter (if any)
+//! @param value    - data parameter (if any)
+//!
+//! @return response (all 1's if the target ignored the command)
+//!
+static U8 bdmTransaction(U8 cmd, U8 txBytes, U8 rxBytes, BdmWait_t wait, U16 addr, U16 value, U16 *result) {
+U8  rc = BDM_RC_OK;
+U8  acked;
+U16 response = 0xFFFF;
+
+   hostWire.transfers++;
+   hostWireCharge(8*(1+txBytes), HCS08_BIT_TICKS);
+   if (cable_status.target_type == T_HC12)
+      acked = hc12Execute(cmd, addr, value, &response);
+   else
+      acked = hcs08Execute(cmd, addr, value, &response);
+   if (wait != WAIT_NONE) {
+      if (cable_status.ackn == ACKN) {
+         if (acked && hcs08.acknEnabled) {
+            hostWireCharge(1, HCS08_BIT_TICKS);                // ACKN pulse
+         }
+         else {
+            halTimerAdvance(TIMER_MICROSECOND(ACKN_TIMEOUTus)); // ACKN timeout
+            rc = BDM_RC_ACK_TIMEOUT;
+         }
+      }
+      else {
+         halTimerAdvance((wait==WAIT_64)?cable_status.wait64_cnt:cable_status.wait150_cnt);
+      }
+   }
+   hostWireCharge(8*rxBytes, HCS08_BIT_TICKS);
+   if (result != NULL)
+      *result = response;
+   return rc;
+}
+
+//=========================================================================
+// BDM commands
+//
+//=========================================================================
+
+void BDM_CMD_0_1B_NOACK(U8 cmd, U8 *result) {
+U16 response;
+   (void)bdmTransaction(cmd, 0, 1, WAIT_NONE, 0, 0, &response);
+   *result = (U8)response;
+}
+
+void BDM_CMD_1B_0_NOACK(U8 cmd, U8 parameter) {
+   (void)bdmTransaction(cmd, 1, 0, WAIT_NONE, 0, parameter, NULL);
+}
+
+void BDM_CMD_0_1W_NOACK(U8 cmd, U16 *parameter) {
+   (void)bdmTransaction(cmd, 0, 2, WAIT_NONE, 0, 0, parameter);
+}
+
+void BDM_CMD_1W_0_NOACK(U8 cmd, U16 parameter) {
+   (void)bdmTransaction(cmd, 2, 0, WAIT_NONE, 0, parameter, NULL);
+}
+
+U8 BDM_CMD_0_0(U8 cmd) {
+   return bdmTransaction(cmd, 0, 0, WAIT_64, 0, 0, NULL);
+}
+
+U8 BDM_CMD_1W_0(U8 cmd, U16 parameter) {
+   return bdmTransaction(cmd, 2, 0, WAIT_64, 0, parameter, NULL);
+}
+
+U8 BDM_CMD_0_1W(U8 cmd, U16 *parameter) {
+   return bdmTransaction(cmd, 0, 2, WAIT_64, 0, 0, parameter);
+}
+
+U8 BDM_CMD_1W_1WB(U8 cmd, U16 parameter, U8 *result) {
+U8  rc;
+U16 response;
+   rc = bdmTransaction(cmd, 2, 2, WAIT_150, parameter, 0, &response);
+   *result = (parameter&0x0001)?(U8)response:(U8)(response>>8);
+   return rc;
+}
+
+U8 BDM_CMD_2W_0(U8 cmd, U16 parameter1, U16 parameter2) {
+   return bdmTransaction(cmd, 4, 0, WAIT_150, parameter1, parameter2, NULL);
+}
+
+U8 BDM_CMD_2WB_0(U8 cmd, U16 parameter1, U8 parameter2) {
+   return bdmTransaction(cmd, 4, 0, WAIT_150, parameter1, parameter2, NULL);
+}
+
+U8 BDM_CMD_1W_1W(U8 cmd, U16 parameter, U16 *result) {
+   return bdmTransaction(cmd, 2, 2, WAIT_150, parameter, 0, result);
+}
+
+U8 BDM_CMD_0_1B(U8 cmd, U8 *result) {
+U8  rc;
+U16 response;
+   rc = bdmTransaction(cmd, 0, 1, WAIT_64, 0, 0, &response);
+   *result = (U8)response;
+   return rc;
+}
+
+U8 BDM_CMD_1B_0(U8 cmd, U8 parameter) {
+   return bdmTransaction(cmd, 1, 0, WAIT_64, 0, parameter, NULL);
+}
+
+U8 BDM_CMD_1W_1B(U8 cmd, U16 parameter, U8 *result) {
+U8  rc;
+U16 response;
+   rc = bdmTransaction(cmd, 2, 1, WAIT_64, parameter, 0, &response);
+   *result = (U8)response;
+   return rc;
+}
+
+U8 BDM_CMD_1W1B_0(U8 cmd, U16 parameter1, U8 parameter2) {
+   return bdmTransaction(cmd, 3, 0, WAIT_150, parameter1, parameter2, NULL);
+}
+
+//=========================================================================
+// BDM sequences - as BDM.c
+//
+//=========================================================================
+
+//! Read Target BDM status
+//!
+//! @param bdm_sts value read
+//! @return
+//!   \ref BDM_RC_OK             => success  \n
+//!   \ref BDM_RC_UNKNOWN_TARGET => unknown target
+//!
+U8 bdm_readBDMStatus(U8 *bdm_sts) {
+
+   switch (cable_status.target_type) {
+      case T_HCS08:
+         BDM08_CMD_READSTATUS(bdm_sts);
+         return BDM_RC_OK;
+      default:
+         return BDM_RC_UNKNOWN_TARGET; // Don't know how to check status on this one!
+   }
+}
+
+//! Write Target BDM control register [masked value]
+//!
+//! @note - This routine may modify the value written if bdm_option.useAltBDMClock is active
+//!
+//! @return
+//!   \ref BDM_RC_OK             => success  \n
+//!   \ref BDM_RC_UNKNOWN_TARGET => unknown target
+//!
+U8 bdm_writeBDMControl(U8 bdm_ctrl) {
+
+   if (cable_status.target_type != T_HCS08)
+      return BDM_RC_UNKNOWN_TARGET; // Don't know how to check status on this one!
+
+   switch (bdm_option.useAltBDMClock) {
+      case CS_ALT:     bdm_ctrl &= ~HC08_BDCSCR_CLKSW;  break; // Force CLKSW = 0
+      case CS_NORMAL:  bdm_ctrl |=  HC08_BDCSCR_CLKSW;  break; // Force CLKSW = 1
+   }
+   BDM08_CMD_WRITECONTROL(bdm_ctrl);
+   return BDM_RC_OK;
+}
+
+//! If BDM mode is not enabled in target yet, enable it so it can be made active
+//!
+//! @return
+//!   \ref BDM_RC_OK             => success  \n
+//!   \ref BDM_RC_UNKNOWN_TARGET => unknown target \n
+//!   \ref BDM_RC_BDM_EN_FAILED  => enabling BDM failed (target not connected or wrong speed ?)
+//!
+U8 bdm_enableBDM() {
+U8 bdm_sts;
+U8 rc;
+
+   rc = bdm_readBDMStatus(&bdm_sts); // Get current status
+   if (rc != BDM_RC_OK) {
+      return rc;
+   }
+   if ((bdm_sts & HC08_BDCSCR_ENBDM) == 0) {
+      // Try to enable BDM
+      bdm_sts |= HC08_BDCSCR_ENBDM;
+      BDM08_CMD_WRITECONTROL(bdm_sts);
+      rc = bdm_readBDMStatus(&bdm_sts); // Get current status
+   }
+   // (bdm_sts==0xFF) often indicates BKGD pin is disabled etc.
+   if ((bdm_sts==0xFF) || (bdm_sts & HC08_BDCSCR_ENBDM) == 0) {
+      return BDM_RC_BDM_EN_FAILED;
+   }
+   return rc;
+}
+
+//! Measures the SYNC length and writes the result into cable_status structure
+//!
+//! @return
+//!   \ref BDM_RC_OK               => Success
+//!
+U8 bdm_syncMeasure(void) {
+
+   hostWire.syncs++;
+   hcs08ResetRelease();
+
+   WAIT_US(BDM_SYNC_REQus);     // SYNC request
+   if (cable_status.target_type == T_HC12) {
+      // Modelled HC12 doesn't support SYNC
+      WAIT_US(SYNC_TIMEOUTus);
+      return BDM_RC_SYNC_TIMEOUT;
+   }
+   // Target waits 16 BDC cycles then drives BKGD low for 128 BDC cycles
+   halTimerAdvance(((16+128)*(TIMER_FREQ/1000UL))/HCS08_BDC_CLOCK_kHz);
+
+   // SYNC length in 60MHz ticks
+   cable_status.sync_length = (U16)((128*60000UL)/HCS08_BDC_CLOCK_kHz);
+   cable_status.speed       = SPEED_SYNC;
+   return BDM_RC_OK;
+}
+
+//! Returns a SYNC value for each Tx routine (trial and error speed detection)
+//!
+//! The model has no Tx routines so only the learned and typical
+//! speeds are tried by bdmHC12_alt_speed_detect()
+//!
+//! @return 0 => no more routines
+//!
+U16 bdm_txSyncGuess(U8 index) {
+   (void)index;
+   return 0;
+}
+
+//! Selects Rx/Tx routines & calculates WAIT times for the measured speed
+//!
+//! @return
+//!   \ref BDM_RC_OK => Success
+//!
+U8 bdm_RxTxSelect(void) {
+
+   bdm_tx_ptr      = bdm_txModel;
+   bdm_txBlock_ptr = bdm_txModelBlock;
+   bdm_rx_ptr      = bdm_rxModel;
+
+   // Calculate timer ticks for 64 & 150 BDM cycles (rounded up)
+   // sync_length is the time for 128 BDM cycles in 60MHz ticks
+   cable_status.wait64_cnt  = (U16)((((U32)cable_status.sync_length*64*(TIMER_FREQ/1000000UL))+(128*60UL-1))/(128*60UL));
+   cable_status.wait150_cnt = (U16)((((U32)cable_status.sync_length*150*(TIMER_FREQ/1000000UL))+(128*60UL-1))/(128*60UL));
+   if (cable_status.wait64_cnt < WAIT_MIN_TICKS)
+      cable_status.wait64_cnt = WAIT_MIN_TICKS;
+   if (cable_status.wait150_cnt < WAIT_MIN_TICKS)
+      cable_status.wait150_cnt = WAIT_MIN_TICKS;
+   return BDM_RC_OK;
+}
+
+//!  Tries to connect to target - doesn't try other strategies such as reset.
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success \n
+//!    != \ref BDM_RC_OK => other failures
+//!
+U8 bdm_physicalConnect(void){
+U8 rc;
+
+   readCacheFlush();                       // Target may have changed since last connected
+   cable_status.speed   = SPEED_NO_INFO;   // No connection
+   bdm_rx_ptr           = bdm_rxEmpty;     // Clear the Tx/Rx pointers
+   bdm_tx_ptr           = bdm_txEmpty;     //    i.e. no com. routines found
+   bdm_txBlock_ptr      = bdm_txBlockEmpty;
+
+   // Target has power?
+   rc = bdm_checkTargetVdd();
+   if (rc != BDM_RC_OK)
+      return rc;
+
+   rc = bdm_syncMeasure();
+   if (rc != BDM_RC_OK) // try again
+      rc = bdm_syncMeasure();
+   if ((rc != BDM_RC_OK) &&                // Trying to measure SYNC was not successful
+       (bdm_option.guessSpeed) &&          // Try alternative method if enabled
+       (cable_status.target_type == T_HC12)) { // and HC12 target
+      rc = bdmHC12_alt_speed_detect();     // Try alternative method (guessing!)
+   }
+   if (rc != BDM_RC_OK)
+      return(rc);
+
+   rc = bdm_RxTxSelect();
+   if (rc != BDM_RC_OK) {
+      cable_status.speed = SPEED_NO_INFO;  // Indicate that we do not have a connection
+      }
+   return(rc);
+}
+
+//! Connect to target
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success  \n
+//!    != \ref BDM_RC_OK => other failures \n
+//!
+U8 bdm_connect(void) {
+U8 rc;
+
+   if (cable_status.speed != SPEED_USER_SUPPLIED) {
+      rc = bdm_physicalConnect();
+      if ((rc != BDM_RC_OK) && bdm_option.cycleVddOnConnect) {
+         // No connection to target - cycle power if allowed
+         (void)bdm_cycleTargetVdd(RESET_SPECIAL); // Ignore errors
+         rc = bdm_physicalConnect(); // Try connect again
+      }
+      if (rc != BDM_RC_OK) {
+         return rc;
+      }
+   }
+   bdm_acknInit();  // Try the ACKN feature
+
+   // Try to enable BDM
+   return bdm_enableBDM();
+}
+
+//! Enables ACKN
+//!
+void bdm_acknInit(void) {
+U8 rc;
+
+   cable_status.ackn = ACKN;              // Switch ACKN on
+
+   // Send the ACK enable command to the target
+   rc = BDM_CMD_ACK_ENABLE();
+
+   // If ACKN fails turn off ACKN (RS08 or early HCS12 target)
+   if (rc == BDM_RC_ACK_TIMEOUT)
+      cable_status.ackn = WAIT;  // Switch the ackn feature off
+}
+
+//! Resets the target using the BDM reset line.
+//!
+//! @param mode
+//!    - \ref RESET_SPECIAL => Reset to special mode,
+//!    - \ref RESET_NORMAL  => Reset to normal mode
+//!
+//! @return
+//!   \ref BDM_RC_OK              => Success \n
+//!   \ref BDM_RC_ILLEGAL_PARAMS  => RESET signal use not enabled
+//!
+U8 bdm_hardwareReset(U8 mode) {
+
+   if (!bdm_option.useResetSignal)
+      return BDM_RC_ILLEGAL_PARAMS;
+      // Doesn't return BDM_RC_ILLEGAL_COMMAND as method is controlled by a parameter
+
+   mode &= RESET_MODE_MASK;
+
+   if (mode==RESET_SPECIAL) {
+      BDM_LOW();  // Drive BKGD low
+      WAIT_MS(RESET_SETTLEms); // Wait for signals to settle
+   }
+
+   RESET_LOW();
+
+   WAIT_MS(RESET_LENGTHms);  // Wait for reset pulse duration
+
+   RESET_3STATE();           // Target samples BKGD leaving reset
+
+   // Wait 1 ms before releasing BKGD
+   WAIT_MS(1);  // Wait for Target to start up after reset
+
+   BDM_3STATE();
+
+   // Wait recovery time before allowing anything else to happen on the BDM
+   WAIT_MS(RESET_RECOVERYms);  // Wait for Target to start up after reset
+
+   return BDM_RC_OK;
+}
+
+//! Resets the target using BDM commands
+//!
+//! @param mode
+//!    - \ref RESET_SPECIAL => Reset to special mode,
+//!    - \ref RESET_NORMAL  => Reset to normal mode
+//!
+//! @return
+//!    \ref BDM_RC_OK                     => Success \n
+//!    \ref BDM_RC_UNKNOWN_TARGET         => Don't know how to reset this type of target! \n
+//!
+U8 bdm_softwareReset(U8 mode) {
+
+   if (cable_status.target_type != T_HCS08)
+      return BDM_RC_UNKNOWN_TARGET; // Don't know how to reset this one!
+
+   mode &= RESET_MODE_MASK;
+
+   // Make sure of connection
+   (void)bdm_connect();
+
+   // Make sure Active background mode (in case target is stopped!)
+   if (bdm_halt() != BDM_RC_OK) {
+      (void)bdm_connect();
+   }
+   (void)BDM08_CMD_WRITEB(HCS08_SBDFR, HCS_SBDFR_BDFR);
+
+   if (mode == RESET_SPECIAL) {  // Special mode - need BKGD held low out of reset
+      BDM_LOW(); // drive BKGD low (out of reset)
+   }
+   WAIT_MS(RESET_SETTLEms);   // Wait for target to start reset
+   hcs08ResetRelease();       // Target samples BKGD leaving reset
+
+   if (mode == RESET_SPECIAL) {   // Special mode - release BKGD
+      WAIT_US(BKGD_WAITus);      // Wait for BKGD assertion time after reset rise
+      BDM_3STATE();
+   }
+   // Wait recovery time before allowing anything else to happen on the BDM
+   WAIT_MS(RESET_RECOVERYms);
+   return BDM_RC_OK;
+}
+
+//! Resets the target
+//!
+//! @param mode
+//!    - \ref RESET_SPECIAL => Reset to special mode,
+//!    - \ref RESET_NORMAL  => Reset to normal mode
+//!
+//! @return
+//!    == \ref BDM_RC_OK  => Success \n
+//!    != \ref BDM_RC_OK  => various errors
+//
+U8 bdm_targetReset( U8 mode ) {
+U8 rc = BDM_RC_OK;
+
+   // Power-cycle-reset - applies to all chips
+   if (bdm_option.cycleVddOnReset)
+      rc = bdm_cycleTargetVdd(mode);
+
+   if (rc != BDM_RC_OK)
+      return rc;
+
+   // Software (BDM Command) reset
+   rc = bdm_softwareReset(mode);
+
+   // Hardware (RESET pin) reset
+   if ((rc != BDM_RC_OK) && bdm_option.useResetSignal)
+      rc = bdm_hardwareReset(mode);
+
+   return rc;
+}
+
+//!  Halts the processor - places in background mode
+//!
+U8 bdm_halt(void) {
+   return BDM_CMD_BACKGROUND();
+}
+
+//! Commences full-speed execution on the target
+//!
+U8 bdm_go(void) {
+   return BDM_CMD_GO();
+}
+
+//!  Executes a single instruction on the target
+//!
+U8 bdm_step(void) {
+   return BDM_CMD_TRACE1();
+}
+
+//! Debug - the BDM timing is not modelled
+//!
+void bdm_checkTiming(void) {
+}
+
+//! Debug - transmit test pattern
+//!
+U8 bdm_testTx(U8 speedIndex) {
+   (void)speedIndex;
+   hostWireCharge(4*8, HCS08_BIT_TICKS);
+   return BDM_RC_OK;
+}
+
+//! Initialises the HCS08 BDM interface
+//!
+void bdmHCS_init(void) {
+   bdm_rx_ptr      = bdm_rxEmpty;
+   bdm_tx_ptr      = bdm_txEmpty;
+   bdm_txBlock_ptr = bdm_txBlockEmpty;
+   BDM_3STATE();
+}
@@ -0,0 +1,279 @@
+/*! \file
+    \brief Host-native replacement for BDMCommon.c & SPI.c
+
+    Timer waits, target Vdd handling and target selection for the target
+    models.  The target models are always powered.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDMCommon.h"
+#include "BDM.h"
+#include "BDM_CF.h"
+#include "SWD.h"
+#include "SPI.h"
+#include "CmdProcessing.h"
+#include "HostModel.h"
+
+HostWireStats_t hostWire;
+uint64_t        hostAbortAtBits;
+U8              hostMemory[HOST_MEMORY_SIZE];
+
+//! Status of the BDM
+//!
+static const CableStatus_t cable_statusDefault =  {
+   T_OFF,             // target_type
+   WAIT,              // ackn
+   NO_RESET_ACTIVITY, // reset
+   SPEED_NO_INFO,     // speed
+   0,                 // power
+   0,                 // flashState
+   0,                 // sync_length
+   0,                 // wait150_cnt
+   0,                 // wait64_cnt
+   0,                 // bdmpprValue
+};
+
+//! Communication speeds supported for SWD, CF V2, 3 & 4 targets (kHz)
+//! These are the SPI rates available from a 24 MHz clock
+//!
+static const U16 spiSpeedValues[] = {
+   12000, 6000, 4000, 3000, 2000, 1500, 1000, 750, 500, 250,
+};
+
+//=========================================================================
+// Model support
+//
+//=========================================================================
+
+//! Charge interface activity to the wire statistics & modelled time
+//!
+//! @param bitCount - number of bits (clock periods)
+//! @param bitTicks - length of each bit in timer ticks
+//!
+void hostWireCharge(U16 bitCount, U16 bitTicks) {
+   hostWire.bits += bitCount;
+   halTimerAdvance((uint32_t)bitCount*bitTicks);
+   if ((hostAbortAtBits != 0) && (hostWire.bits >= hostAbortAtBits)) {
+      // Abort request arrives (as CMD_USBDM_ABORT on EP0)
+      hostAbortAtBits = 0;
+      commandAbort    = TRUE;
+   }
+}
+
+//! Bit time of the SPI based interfaces (SWD, JTAG, CFVx)
+//!
+//! @return bit time in timer ticks
+//!
+U16 hostSpiBitTicks(void) {
+   if (cable_status.sync_length == 0) {
+      return TIMER_MICROSECOND(1000)/DEFAULT_SPI_FREQUENCY;
+   }
+   return TIMER_MICROSECOND(1000)/cable_status.sync_length;
+}
+
+//! Returns all target models to their power-on state
+//!
+//! Memory is erased (0xFF) and the statistics cleared
+//!
+void hostModelReset(void) {
+   (void)memset(hostMemory, 0xFF, sizeof(hostMemory));
+   (void)memset(&hostWire, 0, sizeof(hostWire));
+   hostAbortAtBits = 0;
+   hostHcs08Reset(RESET_NORMAL);
+   hostCfReset(RESET_NORMAL);
+   hostDapReset();
+   hostJtagReset();
+}
+
+//! RESET & BKPT as last seen by halPinsChanged()
+static U8 resetAsserted = FALSE;
+static U8 bkptAsserted  = FALSE;
+
+//! BKPT or RESET pins have changed
+//!
+//!  - RESET released => targets leave reset.
+//!    HCS08 samples BKGD & Coldfire samples BKPT (low => special mode)
+//!  - BKPT asserted  => Coldfire halts
+//!
+void halPinsChanged(void) {
+U8 resetNow = (RESET_OUT_DDR != 0) && (RESET_OUT == 0);
+U8 bkptNow  = (BKPT_OUT_DDR  != 0) && (BKPT_OUT  == 0);
+
+   if (resetAsserted && !resetNow) {
+      hostHcs08Reset(((BDM_OUT_DDR != 0) && (BDM_OUT == 0))?RESET_SPECIAL:RESET_NORMAL);
+      hostCfReset(bkptNow?RESET_SPECIAL:RESET_NORMAL);
+   }
+   else if (!resetNow && !bkptAsserted && bkptNow) {
+      hostCfHalt();
+   }
+   resetAsserted = resetNow;
+   bkptAsserted  = bkptNow;
+}
+
+//=========================================================================
+// Timer routines
+//
+//=========================================================================
+
+//! Wait for given time in timer ticks
+//!
+//!  @param delay Delay time in fast timer ticks
+//!
+//!  @note Modelled time is advanced directly - nothing happens while waiting
+//!
+void fastTimerWait(U16 delay) {
+   halTimerAdvance(delay);
+}
+
+//! Wait for given time in milliseconds
+//!
+//!  @param delay Delay time in milliseconds
+//!
+//!  @note Modelled time is advanced directly - nothing happens while waiting
+//!
+void millisecondTimerWait(U16 delay) {
+   halTimerAdvance((uint32_t)delay*TIMER_MICROSECOND(1000));
+}
+
+//=========================================================================
+// Target Vdd
+//
+//=========================================================================
+
+//!  Checks Target Vdd  - Updates Target Vdd LED & status
+//!
+//!  Updates \ref cable_status
+//!
+U8 bdm_checkTargetVdd(void) {
+   RED_LED_ON();
+   if (bdm_option.targetVdd == BDM_TARGET_VDD_OFF)
+      cable_status.power = BDM_TARGET_VDD_EXT;
+   else
+      cable_status.power = BDM_TARGET_VDD_INT;
+   return BDM_RC_OK;
+}
+
+//! Turns on Target Vdd if enabled.
+//!
+//!  @return
+//!   \ref BDM_RC_OK => Target Vdd confirmed on target
+//!
+U8 bdm_setTargetVdd( void ) {
+   return bdm_checkTargetVdd();
+}
+
+//!  Cycle power to target
+//!
+//! @param mode
+//!    - \ref RESET_SPECIAL => Power on in special mode,
+//!    - \ref RESET_NORMAL  => Power on in normal mode
+//!
+//!  The models are reset as if by power-on (memory is retained)
+//!
+//!  @return
+//!   \ref BDM_RC_OK                 => Target Vdd confirmed on target \n
+//!   \ref BDM_RC_VDD_WRONG_MODE     => Target Vdd not controlled by BDM interface
+//!
+U8 bdm_cycleTargetVdd(U8 mode) {
+
+   if (bdm_option.targetVdd == BDM_TARGET_VDD_OFF)
+      return BDM_RC_VDD_WRONG_MODE;
+
+   // This may take a while
+   setBDMBusy();
+
+   WAIT_MS(1000);
+   mode &= RESET_MODE_MASK;
+   hostHcs08Reset(mode);
+   hostCfReset(mode);
+   hostDapReset();
+   hostJtagReset();
+   return bdm_checkTargetVdd();
+}
+
+//!  Measures Target Vdd
+//!
+//!  @return 255 => Vdd present (target models are always powered)
+//!
+U16 bdm_targetVddMeasure(void) {
+   return 255;
+}
+
+//=========================================================================
+// Common BDM routines
+//
+//=========================================================================
+
+//! Initialises BDM module for the given target type
+//!
+//!  @param target = Target processor (see \ref TargetType_t)
+//!
+U8 bdm_setTarget(U8 target) {
+
+   cable_status             = cable_statusDefault; // Set default status/settings
+   cable_status.target_type = target; // Assume mode is valid
+   (void)bdm_checkTargetVdd();        // Vdd sensing (initTimers()) - target is powered
+
+   switch (target) {
+      case T_HC12:
+      case T_HCS08:
+         bdmHCS_init();
+         break;
+      case T_CFVx:
+         bdm_option.useResetSignal = 1; // Must use RESET signal on CFVx
+         bdmcf_init();                  // Initialise the BDM interface
+         break;
+      case T_JTAG:
+         bdm_option.useResetSignal = 1; // Must use RESET signal on JTAG etc
+         jtag_init();                   // Initialise JTAG
+         break;
+      case T_ARM_JTAG:
+         jtag_init();                   // Initialise JTAG
+         break;
+      case T_ARM_SWD:
+         swd_init();                    // Initialise SWD
+         break;
+      case T_OFF:
+         return BDM_RC_OK;
+
+      default:
+         cable_status.target_type = T_OFF; // Safe mode!
+         return BDM_RC_UNKNOWN_TARGET;
+   }
+   return BDM_RC_OK;
+}
+
+//=========================================================================
+// SPI
+//
+//=========================================================================
+
+//! Sets Communication speed for SWD, CF V2, 3 & 4 targets
+//!
+//! @param freq => Frequency on kHz (0 => use default value)
+//!
+//! @return  \ref BDM_RC_OK              => Success                 \n
+//!          \ref BDM_RC_ILLEGAL_PARAMS  => Speed is not supported
+//!
+U8 spi_setSpeed(U16 freq) {
+U8 sub;
+
+   if (freq == 0) {
+      freq = DEFAULT_SPI_FREQUENCY;
+   }
+   for (sub = 0; sub<sizeof(spiSpeedValues)/sizeof(spiSpeedValues[0]); sub++) {
+      if (spiSpeedValues[sub] <= freq) {
+         cable_status.sync_length = spiSpeedValues[sub];
+         return BDM_RC_OK;
+      }
+   }
+   return BDM_RC_ILLEGAL_PARAMS;
+}
@@ -0,0 +1,605 @@
+/*! \file
+    \brief Host-native replacement for BDM_CF.c - Coldfire V2, V3 & V4 target model
+
+    Models the Coldfire BDM serial interface at the level of 17-bit packets.
+    Each packet carries a status bit & 16 data bits in each direction and the
+    response received is that of the previous packet:
+    - {0, data}    - data word of a read/dump
+    - {0, 0xFFFF}  - command complete
+    - {1, 0x0000}  - not ready (command still being received)
+    - {1, 0xFFFF}  - illegal command
+
+    The packet routines above bdmcf_txrx_start()/bdmcf_txRx16() are those of BDM_CF.c.
+
+    The command processing code moves 16-bit words between byte buffers with
+    native loads & stores (*(U16*)ptr).  On the (big-endian) HCS08 the byte image
+    of a buffer is the Coldfire byte order.  The model decodes the words through
+    their native byte image so that this holds on any host:
+    - Register values & 16/32-bit memory data - the byte image is big-endian
+    - Memory addresses - the byte image is a native U32 (as in the command)
+    - Byte data & control register numbers - the word value
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDM.h"
+#include "BDM_CF.h"
+#include "bdmcfMacros.h"
+#include "CmdProcessing.h"
+#include "BDMCommon.h"
+#include "SPI.h"
+#include "TargetDefines.h"
+#include "HostModel.h"
+
+#define CF_NUM_CREGS  (0x1000)   //!< Control register address space (12 bits)
+#define CF_CREG_PC    (0x080F)   //!< Program counter
+#define CF_CREG_SR    (0x080E)   //!< Status register
+
+//! State of the modelled Coldfire
+static struct {
+   U8  halted;               //!< Processor halted (BDM)
+   U8  extCount;             //!< # of extension words still to be received
+   U8  extIndex;             //!< # of extension words received
+   U16 command;              //!< Command being received
+   U16 ext[4];               //!< Extension words
+   U32 lastAddress;          //!< Address of last READ/WRITE (for DUMP/FILL)
+   U8  respStatus;           //!< Status bit of the response to the next packet
+   U16 respData;             //!< Data of the response to the next packet (if queue empty)
+   U8  queueCount;           //!< # of data words queued for the following packets
+   U16 queue[2];             //!< Data words (read results)
+   U8  packetStarted;        //!< bdmcf_txrx_start() has sent the status bit
+   U32 dreg[16];             //!< D0-D7, A0-A7
+   U32 dmreg[32];            //!< Debug module registers (CSR = 0)
+   U32 creg[CF_NUM_CREGS];   //!< Control registers
+} cf;
+
+//=========================================================================
+// Word <=> byte image conversions
+//
+//=========================================================================
+
+//! Byte image of a 32-bit value sent as two words (native stores of the buffer)
+//!
+static void cfImage(U16 w1, U16 w2, U8 image[4]) {
+   (void)memcpy(image,   &w1, 2);
+   (void)memcpy(image+2, &w2, 2);
+}
+
+//! Word that stores as the given two bytes
+//!
+static U16 cfWord(U8 b1, U8 b2) {
+U8  image[2];
+U16 word;
+   image[0] = b1;
+   image[1] = b2;
+   (void)memcpy(&word, image, 2);
+   return word;
+}
+
+//! Address from two words (native U32 in the command buffer)
+//!
+static U32 cfAddress(U16 w1, U16 w2) {
+U8  image[4];
+U32 address;
+   cfImage(w1, w2, image);
+   (void)memcpy(&address, image, 4);
+   return address;
+}
+
+//! Big-endian value (register) from two words
+//!
+static U32 cfValue(U16 w1, U16 w2) {
+U8 image[4];
+   cfImage(w1, w2, image);
+   return ((U32)image[0]<<24)|((U32)image[1]<<16)|((U32)image[2]<<8)|image[3];
+}
+
+//! Queue a big-endian value (register) as two response words
+//!
+static void cfQueueValue(U32 value) {
+   cf.queue[0]   = cfWord((U8)(value>>24), (U8)(value>>16));
+   cf.queue[1]   = cfWord((U8)(value>>8),  (U8)value);
+   cf.queueCount = 2;
+}
+
+//=========================================================================
+// Target model
+//
+//=========================================================================
+
+//! Reset the modelled Coldfire
+//!
+//! @param mode
+//!    - \ref RESET_SPECIAL => Reset to special mode (BKPT asserted, target halted)
+//!    - \ref RESET_NORMAL  => Reset to normal mode (target executes)
+//!
+//! SP & PC are loaded from the vector table at address 0
+//!
+void hostCfReset(U8 mode) {
+   (void)memset(cf.dreg,  0, sizeof(cf.dreg));
+   (void)memset(cf.dmreg, 0, sizeof(cf.dmreg));
+   (void)memset(cf.creg,  0, sizeof(cf.creg));
+   cf.dreg[15]          = ((U32)HOST_MEM(0)<<24)|((U32)HOST_MEM(1)<<16)|((U32)HOST_MEM(2)<<8)|HOST_MEM(3);
+   cf.creg[CF_CREG_PC]  = ((U32)HOST_MEM(4)<<24)|((U32)HOST_MEM(5)<<16)|((U32)HOST_MEM(6)<<8)|HOST_MEM(7);
+   cf.creg[CF_CREG_SR]  = 0x2700;
+   cf.halted            = ((mode&RESET_MODE_MASK) == RESET_SPECIAL);
+   cf.extCount          = 0;
+   cf.queueCount        = 0;
+   cf.respStatus        = BDMCF_STATUS_OK;
+   cf.respData          = BDMCF_RES_OK;
+   cf.packetStarted     = FALSE;
+   cf.lastAddress       = 0;
+}
+
+//! Halt the modelled Coldfire (BKPT asserted)
+//!
+void hostCfHalt(void) {
+   cf.halted     = TRUE;
+   cf.dmreg[0]  |= CFVx_CSR_BKPT;
+}
+
+//! Number of extension words following a command
+//!
+//! @return # of words, 0xFF => illegal command
+//!
+static U8 cfExtCount(U16 command) {
+U8 size = (U8)((command>>6)&0x03); // 0 => byte, 1 => word, 2 => long
+
+   switch (command&0xFFC0) {
+      case BDMCF_CMD_READ8:  case BDMCF_CMD_READ16:  case BDMCF_CMD_READ32:
+         return (size<=2)?2:0xFF;
+      case BDMCF_CMD_WRITE8: case BDMCF_CMD_WRITE16: case BDMCF_CMD_WRITE32:
+         return (size<=2)?((size==2)?4:3):0xFF;
+      case BDMCF_CMD_DUMP8:  case BDMCF_CMD_DUMP16:  case BDMCF_CMD_DUMP32:
+         return (size<=2)?0:0xFF;
+      case BDMCF_CMD_FILL8:  case BDMCF_CMD_FILL16:  case BDMCF_CMD_FILL32:
+         return (size<=2)?((size==2)?2:1):0xFF;
+   }
+   if ((command == BDMCF_CMD_NOP) || (command == BDMCF_CMD_GO))
+      return 0;
+   if ((command&0xFFE0) == BDMCF_CMD_RDMREG)
+      return 0;
+   if ((command&0xFFE0) == BDMCF_CMD_WDMREG)
+      return 2;
+   if ((command&0xFFF0) == BDMCF_CMD_RAREG)
+      return 0;
+   if ((command&0xFFF0) == BDMCF_CMD_WAREG)
+      return 2;
+   if (command == BDMCF_CMD_RCREG)
+      return 2;
+   if (command == BDMCF_CMD_WCREG)
+      return 4;
+   return 0xFF;
+}
+
+//! Read target memory & queue the data words
+//!
+static void cfReadMemory(U8 size) {
+U32 address = cf.lastAddress;
+
+   switch (size) {
+      case 0:
+         cf.queue[0]   = cfWord(0, HOST_MEM(address));
+         cf.queueCount = 1;
+         break;
+      case 1:
+         cf.queue[0]   = cfWord(HOST_MEM(address), HOST_MEM(address+1));
+         cf.queueCount = 1;
+         break;
+      default:
+         cf.queue[0]   = cfWord(HOST_MEM(address),   HOST_MEM(address+1));
+         cf.queue[1]   = cfWord(HOST_MEM(address+2), HOST_MEM(address+3));
+         cf.queueCount = 2;
+         break;
+   }
+}
+
+//! Write target memory from the data words
+//!
+static void cfWriteMemory(U8 size, const U16 *data) {
+U32 address = cf.lastAddress;
+U8  image[4];
+
+   switch (size) {
+      case 0:
+         HOST_MEM(address) = (U8)data[0];
+         break;
+      case 1:
+         (void)memcpy(image, &data[0], 2);
+         HOST_MEM(address)   = image[0];
+         HOST_MEM(address+1) = image[1];
+         break;
+      default:
+         cfImage(data[0], data[1], image);
+         HOST_MEM(address)   = image[0];
+         HOST_MEM(address+1) = image[1];
+         HOST_MEM(address+2) = image[2];
+         HOST_MEM(address+3) = image[3];
+         break;
+   }
+}
+
+//! Execute a complete command
+//!
+//! Sets the response for the following packet(s)
+//!
+static void cfExecute(void) {
+U16 command = cf.command;
+U8  size    = (U8)((command>>6)&0x03);
+U8  reg     = (U8)(command&0x1F);
+
+   cf.respStatus = BDMCF_STATUS_OK;
+   cf.respData   = BDMCF_RES_OK;
+
+   switch (command&0xFFC0) {
+      case BDMCF_CMD_READ8:  case BDMCF_CMD_READ16:  case BDMCF_CMD_READ32:
+         cf.lastAddress = cfAddress(cf.ext[0], cf.ext[1]);
+         cfReadMemory(size);
+         return;
+      case BDMCF_CMD_DUMP8:  case BDMCF_CMD_DUMP16:  case BDMCF_CMD_DUMP32:
+         cf.lastAddress += 1U<<size;
+         cfReadMemory(size);
+         return;
+      case BDMCF_CMD_WRITE8: case BDMCF_CMD_WRITE16: case BDMCF_CMD_WRITE32:
+         cf.lastAddress = cfAddress(cf.ext[0], cf.ext[1]);
+         cfWriteMemory(size, cf.ext+2);
+         return;
+      case BDMCF_CMD_FILL8:  case BDMCF_CMD_FILL16:  case BDMCF_CMD_FILL32:
+         cf.lastAddress += 1U<<size;
+         cfWriteMemory(size, cf.ext);
+         return;
+   }
+   if (command == BDMCF_CMD_NOP) {
+      return;
+   }
+   if ((command&0xFFE0) == BDMCF_CMD_RDMREG) {
+      cfQueueValue(cf.dmreg[reg]|(cf.halted?CFVx_CSR_HALT:0));
+      return;
+   }
+   if ((command&0xFFE0) == BDMCF_CMD_WDMREG) {
+      cf.dmreg[reg] = cfValue(cf.ext[0], cf.ext[1]);
+      return;
+   }
+   // Processor registers & GO - target must be halted
+   if (!cf.halted) {
+      cf.respStatus = !BDMCF_STATUS_OK;
+      cf.respData   = BDMCF_RES_ILLEGAL;
+      return;
+   }
+   if (command == BDMCF_CMD_GO) {
+      if (cf.dmreg[0]&CFVx_CSR_SSM)
+         cf.creg[CF_CREG_PC] += 2; // Every instruction is a NOP
+      else
+         cf.halted = FALSE;
+      cf.dmreg[0] &= ~CFVx_CSR_BKPT;
+   }
+   else if ((command&0xFFF0) == BDMCF_CMD_RAREG) {
+      cfQueueValue(cf.dreg[reg&0x0F]);
+   }
+   else if ((command&0xFFF0) == BDMCF_CMD_WAREG) {
+      cf.dreg[reg&0x0F] = cfValue(cf.ext[0], cf.ext[1]);
+   }
+   else if (command == BDMCF_CMD_RCREG) {
+      cfQueueValue(cf.creg[cf.ext[1]&(CF_NUM_CREGS-1)]);
+   }
+   else if (command == BDMCF_CMD_WCREG) {
+      cf.creg[cf.ext[1]&(CF_NUM_CREGS-1)] = cfValue(cf.ext[2], cf.ext[3]);
+   }
+}
+
+//! Receive a packet from the BDM
+//!
+//! @param data - 16-bit data from BDM
+//!
+static void cfReceive(U16 data) {
+
+   if (cf.extCount > 0) {
+      cf.ext[cf.extIndex++] = data;
+      if (--cf.extCount == 0) {
+         cfExecute();
+      }
+      return;
+   }
+   // New command - NOPs are sent while the data of a read is returned
+   if (data != BDMCF_CMD_NOP)
+      cf.queueCount = 0;
+   cf.command    = data;
+   cf.extIndex   = 0;
+   cf.extCount   = cfExtCount(data);
+   if (cf.extCount == 0xFF) {
+      cf.extCount   = 0;
+      cf.respStatus = !BDMCF_STATUS_OK;
+      cf.respData   = BDMCF_RES_ILLEGAL;
+   }
+   else if (cf.extCount == 0) {
+      cfExecute();
+   }
+}
+
+//=========================================================================
+// Packet interface (replaces the SPI/asm routines of BDM_CF.c)
+//
+//=========================================================================
+
+//! Transmits 1 bit of logic low value and receives 1 bit
+//!
+//! @return received data (status bit of the packet)
+//!
+U8 bdmcf_txrx_start(void) {
+
+   hostWireCharge(1, hostSpiBitTicks());
+   cf.packetStarted = TRUE;
+   if (cf.extCount > 0)
+      return !BDMCF_STATUS_OK;   // Not ready - command incomplete
+   if (cf.queueCount > 0)
+      return BDMCF_STATUS_OK;
+   return cf.respStatus;
+}
+
+//! Transmits & receives 16 bits
+//! Assumes start bit has been sent
+//!
+//! @param data => data to Tx
+//!
+//! @return 16-bit received
+//!
+U16 bdmcf_txRx16(U16 data) {
+U16 response;
+
+   hostWireCharge(16, hostSpiBitTicks());
+   hostWire.transfers++;
+   if (!cf.packetStarted) {
+      // Status bit not sent - target sees a corrupted packet
+      return BDMCF_RES_ILLEGAL;
+   }
+   cf.packetStarted = FALSE;
+
+   if (cf.extCount > 0) {
+      response = BDMCF_RES_NOT_READY;
+   }
+   else if (cf.queueCount > 0) {
+      response = cf.queue[0];
+      cf.queue[0] = cf.queue[1];
+      cf.queueCount--;
+   }
+   else {
+      response = cf.respData;
+   }
+   cfReceive(data);
+   return response;
+}
+
+//! Transmits 16 bits, discards Rx data
+//!
+//! @param data => data to Tx
+//!
+static void bdmcf_tx16(U16 data) {
+   (void)bdmcf_txRx16(data);
+}
+
+//=========================================================================
+// Packet routines - as BDM_CF.c
+//
+//=========================================================================
+
+//! Transmits a series of 17 bit messages
+//!
+//! @param count => number of messages to send
+//! @param data  => pointer to message data buffer
+//!
+//! @note The first byte in the buffer is the MSB of the first message
+//!
+void bdmcf_tx(U8 count, U8 *data) {
+   while(count--) {
+      (void)bdmcf_txrx_start();
+      bdmcf_tx16(*(U16*)data);
+      data+=2;
+   }
+}
+
+//! Waits for command complete indication & send the next command.
+//!
+//! @param  next_cmd => next command to send
+//!
+//! @return  \ref BDM_RC_OK                    => Success                                \n
+//!          \ref BDM_RC_CF_BUS_ERROR          => Target returned Bus Error              \n
+//!          \ref BDM_RC_CF_ILLEGAL_COMMAND    => Target returned Illegal Command error  \n
+//!          \ref BDM_RC_NO_CONNECTION         => No connection / unexpected response
+//!
+//! @note The next command is sent, the return value is for the \b PREVIOUS command. \n
+//!       On error the next command, although sent, would be ignored by the target
+//!
+U8 bdmcf_complete_chk(U16 next_cmd) {
+U8 retryCount = BDMCF_RETRY;
+U8 status;
+U16 returnData;
+
+   do {
+      status     = bdmcf_txrx_start();
+      returnData = bdmcf_txRx16(next_cmd);
+      if (status == BDMCF_STATUS_OK) {
+         return(BDM_RC_OK);
+      }
+      if (returnData != BDMCF_RES_NOT_READY) {
+         break;
+      }
+   } while ((retryCount--)>0);
+
+   switch (returnData) {
+      case BDMCF_RES_BUS_ERROR : return BDM_RC_CF_BUS_ERROR;
+      case BDMCF_RES_ILLEGAL   : return BDM_RC_CF_ILLEGAL_COMMAND;
+      default                  : return BDM_RC_NO_CONNECTION;
+   }
+}
+
+//! Waits for command completion [Send NOPs while waiting]
+//!
+//! @return  \ref BDM_RC_OK                    => Success                                \n
+//!          \ref BDM_RC_CF_BUS_ERROR          => Target returned Bus Error              \n
+//!          \ref BDM_RC_CF_ILLEGAL_COMMAND    => Target returned Illegal Command error  \n
+//!          \ref BDM_RC_NO_CONNECTION         => No connection / unexpected response
+//!
+U8 bdmcf_complete_chk_rx(void) {
+   return bdmcf_complete_chk(BDMCF_CMD_NOP);
+}
+
+//! Receives a series of 17 bit messages & Transmits next command
+//!
+//! @param count       => number of messages to receive
+//! @param dataPtr     => pointer to message data buffer
+//! @param nextCommand => next command to send
+//!
+//! @return  \ref BDM_RC_OK                    => Success                                \n
+//!          \ref BDM_RC_CF_BUS_ERROR          => Target returned Bus Error              \n
+//!          \ref BDM_RC_CF_ILLEGAL_COMMAND    => Target returned Illegal Command error  \n
+//!          \ref BDM_RC_NO_CONNECTION         => No connection / unexpected response
+//!
+//! @note The first byte stored in the buffer is the MSB of the first message
+//! @note Transmits the next command while receiving the last message
+//!
+U8 bdmcf_rxtx(U8 count, U8 *dataPtr, U16 nextCommand) {
+U8   retryCount,status;
+U16  data;
+U16  dataOut = BDMCF_CMD_NOP; // Dummy command to send
+
+   while(count>0) {
+      retryCount = BDMCF_RETRY;
+
+      count--;
+      if (count == 0) {          // Last word to Tx?
+         dataOut = nextCommand;  // Yes - send next command
+      }
+      do {
+         status = bdmcf_txrx_start();
+         data   = bdmcf_txRx16( dataOut );
+         if (status == BDMCF_STATUS_OK)
+            break;
+         if (data != BDMCF_RES_NOT_READY)
+            break;
+      } while ((retryCount--)>0);
+
+      if (status != BDMCF_STATUS_OK)
+         switch (data) {
+            case BDMCF_RES_BUS_ERROR : return BDM_RC_CF_BUS_ERROR;
+            case BDMCF_RES_ILLEGAL   : return BDM_RC_CF_ILLEGAL_COMMAND;
+            default                  : return BDM_RC_NO_CONNECTION;
+         }
+      *(U16*)dataPtr  = data;
+      dataPtr        += 2;
+   }
+   return(BDM_RC_OK);
+}
+
+//! Receives series of 17 bit messages [TxData = BDMCF_CMD_NOP]
+//!
+//! @param count    => number of messages to receive
+//! @param dataPtr  => pointer to message data buffer
+//!
+U8 bdmcf_rx(U8 count, U8 *dataPtr) {
+   return bdmcf_rxtx(count, dataPtr, BDMCF_CMD_NOP);
+}
+
+//! Transmits a 17 bit message
+//!
+//! @param data  => data to Tx
+//!
+//! @return status bit
+//!
+U8 bdmcf_tx_msg(U16 data) {
+U8 status;
+
+   status = bdmcf_txrx_start();
+   bdmcf_tx16(data);
+   return(status);
+}
+
+//! Transmits a 17 bit message
+//!
+//! @param dataOut  => data to Tx
+//!
+//! @return  \ref BDM_RC_OK                    => Success                                \n
+//!          \ref BDM_RC_CF_BUS_ERROR          => Target returned Bus Error              \n
+//!          \ref BDM_RC_CF_ILLEGAL_COMMAND    => Target returned Illegal Command error  \n
+//!          \ref BDM_RC_NO_CONNECTION         => No connection / unexpected response
+//!
+//! @note To be used for transmitting the second message in a multi-message command which can fail \n
+//!      (e.g. because target is not halted). The correct target response in these cases is Not Ready
+//!
+U8 bdmcf_tx_msg_half_rx(U16 dataOut) {
+U16 dataIn;
+
+   (void)bdmcf_txrx_start();
+   dataIn = bdmcf_txRx16(dataOut);
+   switch (dataIn) {
+      case BDMCF_RES_BUS_ERROR : return BDM_RC_CF_BUS_ERROR;
+      case BDMCF_RES_ILLEGAL   : return BDM_RC_CF_ILLEGAL_COMMAND;
+      case BDMCF_RES_NOT_READY : return BDM_RC_OK;
+      default                  : return BDM_RC_NO_CONNECTION;
+   }
+}
+
+//! Receives a 17 bit message while sending a NOP
+//!
+//! @param data  => pointer to where to store the Rx data
+//!
+//! @return status bit
+//!
+U8 bdmcf_rx_msg(U16 *data) {
+U8 status;
+   status  = bdmcf_txrx_start();
+   *data   = bdmcf_txRx16(BDMCF_CMD_NOP);
+   return(status);
+}
+
+//! Resynchronizes communication with the target in case of noise on the CLK line, etc.
+//!
+//! @return  \ref BDM_RC_OK                    => success                     \n
+//!          \ref BDM_RC_NO_CONNECTION         => no connection with target
+//!
+U8 bdmcf_resync(void) {
+U8  bitCount;
+U16 data;
+
+   (void)bdmcf_tx_msg(BDMCF_CMD_NOP);     // Send in 3 NOPs to clear any error
+   (void)bdmcf_tx_msg(BDMCF_CMD_NOP);
+   (void)bdmcf_rx_msg(&data);
+   if ((data&3)==0) {
+      // The last NOP did not return the expected value (at least one of the two bits should be 1)
+      return(BDM_RC_NO_CONNECTION);
+   }
+   for (bitCount=20; bitCount>0; bitCount--) {
+      // Now start sending in another NOP and watch the result
+      if (bdmcf_txrx_start()==0) {
+         break;   // The first 0 is the status bit
+      }
+   }
+   if (bitCount==0) { // No status bit found in 20 bits
+      return(BDM_RC_NO_CONNECTION);
+   }
+   // Transmitted & received the status bit, finish the NOP
+   bdmcf_tx16(BDMCF_CMD_NOP);
+
+   return(BDM_RC_OK);
+}
+
+//!  Sets the CF BDM interface hardware to an idle condition
+//!
+void bdmcf_interfaceIdle(void) {
+   RESET_3STATE();
+   TA_3STATE();
+   BKPT_HIGH();
+}
+
+//! Initialises the CF BDM interface to default state (including speed)
+//!
+void bdmcf_init(void) {
+   bdmcf_interfaceIdle();
+   (void)spi_setSpeed(0);
+}
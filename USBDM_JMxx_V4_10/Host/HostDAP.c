@@ -0,0 +1,288 @@
+/*! \file
+    \brief ARM Debug Access Port model for the host-native build
+
+    Shared by the ARM-SWD (HostSWD.c) and ARM-JTAG (HostJTAG.c) models.
+
+    - Debug Port  - IDCODE, ABORT, CTRL/STAT, SELECT & RDBUFF
+    - AP #0       - MEM-AP (AHB-AP) with CSW, TAR, DRW & IDR
+    - Memory      - the shared model memory plus the core debug registers
+                    DHCSR, DCRSR & DCRDR of a Cortex-M core (halt, step & register access)
+
+    Accesses are not posted here - the value read is returned immediately.
+    AP reads are also kept as the read buffer (RDBUFF).  The SWD & JTAG layers apply the
+    posting rules of their protocol.
+
+    AP accesses FAULT (and set STICKYERR) until debug power-up has been
+    requested in CTRL/STAT or while STICKYERR remains set.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDM.h"
+#include "CmdProcessing.h"
+#include "TargetDefines.h"
+#include "HostModel.h"
+
+// DP registers (A[3:2])
+#define DP_IDCODE_ABORT     (0x0)  //!< Read IDCODE, Write ABORT
+#define DP_CTRL_STAT        (0x4)  //!< CTRL/STAT
+#define DP_SELECT_RESEND    (0x8)  //!< Write SELECT, Read RESEND
+#define DP_RDBUFF           (0xC)  //!< Read buffer
+
+// CTRL/STAT bits
+#define CTRL_STAT_CSYSPWRUPACK  (1UL<<31)
+#define CTRL_STAT_CSYSPWRUPREQ  (1UL<<30)
+#define CTRL_STAT_CDBGPWRUPACK  (1UL<<29)
+#define CTRL_STAT_CDBGPWRUPREQ  (1UL<<28)
+#define CTRL_STAT_STICKYERR     (1UL<<5)
+#define CTRL_STAT_REQ_MASK      (0x5F000F00UL) //!< Writable bits (not including the W1C sticky bits)
+
+// ABORT bits clearing the sticky flags (STKCMPCLR, STKERRCLR, WDERRCLR, ORUNERRCLR)
+#define ABORT_CLEAR_MASK        (0x1EUL)
+
+// MEM-AP registers (APBANKSEL:A[3:2])
+#define AP_CSW                  (0x00)
+#define AP_TAR                  (0x04)
+#define AP_DRW                  (0x0C)
+#define AP_IDR                  (0xFC)
+
+#define AP_CSW_RESET_VALUE      (0x23000040UL) //!< Reset value (DeviceEn set)
+#define AP_CSW_WRITE_MASK       (0xFF00003FUL) //!< Writable bits
+#define AP_IDR_VALUE            (0x24770011UL) //!< AHB-AP
+
+// Core debug registers
+#define SCS_DHCSR               (0xE000EDF0UL)
+#define SCS_DCRSR               (0xE000EDF4UL)
+#define SCS_DCRDR               (0xE000EDF8UL)
+
+#define DHCSR_DBGKEY            (0xA05F0000UL)
+#define DHCSR_S_HALT            (1UL<<17)
+#define DHCSR_S_REGRDY          (1UL<<16)
+#define DHCSR_C_MASKINTS        (1UL<<3)
+#define DHCSR_C_STEP            (1UL<<2)
+#define DHCSR_C_HALT            (1UL<<1)
+#define DHCSR_C_DEBUGEN         (1UL<<0)
+#define DHCSR_C_MASK            (0x2FUL)
+
+#define DCRSR_REGWnR            (1UL<<16)
+#define DCRSR_REGSEL            (0x7FUL)
+
+#define CORE_NUM_REGS           (128)
+#define CORE_PC                 (15)
+
+//! State of the modelled DAP & core
+static struct {
+   U32 ctrlStat;              //!< DP CTRL/STAT
+   U32 select;                //!< DP SELECT
+   U32 readBuffer;            //!< Last value read (RDBUFF)
+   U32 csw;                   //!< MEM-AP CSW
+   U32 tar;                   //!< MEM-AP TAR
+   U32 dhcsr;                 //!< Core DHCSR control bits
+   U32 dcrdr;                 //!< Core DCRDR
+   U8  halted;                //!< Core halted
+   U32 core[CORE_NUM_REGS];   //!< Core registers (R0-R15, xPSR, MSP, PSP ...)
+} dap;
+
+//! Reset the modelled DAP & core (power-on)
+//!
+void hostDapReset(void) {
+   (void)memset(&dap, 0, sizeof(dap));
+   dap.csw = AP_CSW_RESET_VALUE;
+}
+
+//! Value of the DP read buffer (result of the last AP read)
+//!
+U32 hostDapReadBuffer(void) {
+   return dap.readBuffer;
+}
+
+//=========================================================================
+// Memory (AHB) side
+//
+//=========================================================================
+
+//! Read 32-bit word from the target memory
+//!
+//! @param address - word aligned address
+//!
+static U32 dapReadWord(U32 address) {
+   switch (address) {
+      case SCS_DHCSR:
+         return dap.dhcsr|DHCSR_S_REGRDY|(dap.halted?DHCSR_S_HALT:0);
+      case SCS_DCRDR:
+         return dap.dcrdr;
+      case SCS_DCRSR:
+         return 0; // Write only
+   }
+   return ((U32)HOST_MEM(address+3)<<24)|((U32)HOST_MEM(address+2)<<16)|
+          ((U32)HOST_MEM(address+1)<<8)|HOST_MEM(address);
+}
+
+//! Write to the core debug registers
+//!
+static void dapWriteDebugReg(U32 address, U32 value) {
+U8 reg;
+
+   switch (address) {
+      case SCS_DHCSR:
+         if ((value&0xFFFF0000UL) != DHCSR_DBGKEY)
+            return;   // Key required
+         dap.dhcsr = value&DHCSR_C_MASK;
+         if ((value&DHCSR_C_DEBUGEN) == 0) {
+            dap.halted = FALSE;
+         }
+         else if (value&DHCSR_C_HALT) {
+            dap.halted = TRUE;
+         }
+         else if (value&DHCSR_C_STEP) {
+            if (dap.halted)
+               dap.core[CORE_PC] += 2;  // Every instruction is a 16-bit NOP
+         }
+         else {
+            dap.halted = FALSE;
+         }
+         break;
+      case SCS_DCRSR:
+         reg = (U8)(value&DCRSR_REGSEL);
+         if (value&DCRSR_REGWnR)
+            dap.core[reg] = dap.dcrdr;
+         else
+            dap.dcrdr = dap.core[reg];
+         break;
+      case SCS_DCRDR:
+         dap.dcrdr = value;
+         break;
+   }
+}
+
+//! Write the byte lanes of a transfer to the target memory
+//!
+//! @param address - address of transfer
+//! @param size    - transfer size (0 => byte, 1 => halfword, 2 => word)
+//! @param value   - data (byte lanes as on the AHB)
+//!
+static void dapWrite(U32 address, U8 size, U32 value) {
+U8 lane;
+U8 last;
+
+   if ((address&~3UL) == SCS_DHCSR || (address&~3UL) == SCS_DCRSR || (address&~3UL) == SCS_DCRDR) {
+      dapWriteDebugReg(address&~3UL, value);
+      return;
+   }
+   lane = (U8)(address&3);
+   switch (size) {
+      case 0:  last = lane;         break;
+      case 1:  lane &= 2; last = lane+1; break;
+      default: lane  = 0; last = 3;      break;
+   }
+   for (; lane<=last; lane++) {
+      HOST_MEM((address&~3UL)+lane) = (U8)(value>>(8*lane));
+   }
+}
+
+//=========================================================================
+// DP & AP registers
+//
+//=========================================================================
+
+//! Access a MEM-AP register
+//!
+static U8 dapApAccess(U8 RnW, U8 regAddr, U32 *data) {
+U8 size = (U8)(dap.csw&AHB_AP_CSW_SIZE_MASK);
+
+   if (((dap.ctrlStat&CTRL_STAT_CDBGPWRUPACK) == 0) || (dap.ctrlStat&CTRL_STAT_STICKYERR)) {
+      dap.ctrlStat |= CTRL_STAT_STICKYERR;
+      return HOST_DAP_ACK_FAULT;
+   }
+   if ((dap.select>>24) != AHB_AP_NUM) {
+      // Unimplemented AP - RAZ/WI
+      if (RnW)
+         *data = 0;
+      return HOST_DAP_ACK_OK;
+   }
+   regAddr |= (U8)(dap.select&0xF0); // APBANKSEL
+   if (RnW) {
+      switch (regAddr) {
+         case AP_CSW: *data = dap.csw;                  break;
+         case AP_TAR: *data = dap.tar;                  break;
+         case AP_DRW: *data = dapReadWord(dap.tar&~3UL); break;
+         case AP_IDR: *data = AP_IDR_VALUE;             break;
+         default:     *data = 0;                        break;
+      }
+   }
+   else {
+      switch (regAddr) {
+         case AP_CSW: dap.csw = (*data&AP_CSW_WRITE_MASK)|(AP_CSW_RESET_VALUE&~AP_CSW_WRITE_MASK); break;
+         case AP_TAR: dap.tar = *data;                   break;
+         case AP_DRW: dapWrite(dap.tar, size, *data);    break;
+      }
+   }
+   if ((regAddr == AP_DRW) && ((dap.csw&AHB_AP_CSW_INC_MASK) == AHB_AP_CSW_INC_SINGLE)) {
+      dap.tar += 1UL<<size;
+   }
+   return HOST_DAP_ACK_OK;
+}
+
+//! Access a DP or AP register
+//!
+//! @param APnDP   - 0 => DP, 1 => AP
+//! @param RnW     - 0 => write, 1 => read
+//! @param regAddr - register address A[3:2] (0x0, 0x4, 0x8 or 0xC)
+//! @param data    - value to write or value read
+//!
+//! @return \ref HOST_DAP_ACK_OK or \ref HOST_DAP_ACK_FAULT
+//!
+//! @note The value read is returned immediately (not posted)
+//!
+U8 hostDapAccess(U8 APnDP, U8 RnW, U8 regAddr, U32 *data) {
+U8 ack = HOST_DAP_ACK_OK;
+
+   regAddr &= 0x0C;
+   if (APnDP) {
+      ack = dapApAccess(RnW, regAddr, data);
+   }
+   else if (RnW) {
+      switch (regAddr) {
+         case DP_IDCODE_ABORT:
+            *data = (cable_status.target_type == T_ARM_SWD)?HOST_DAP_SWD_IDCODE:HOST_DAP_JTAG_IDCODE;
+            break;
+         case DP_CTRL_STAT:
+            *data = dap.ctrlStat;
+            break;
+         case DP_SELECT_RESEND:
+         case DP_RDBUFF:
+            *data = dap.readBuffer;
+            break;
+      }
+   }
+   else {
+      switch (regAddr) {
+         case DP_IDCODE_ABORT:
+            if (*data&ABORT_CLEAR_MASK)
+               dap.ctrlStat &= ~CTRL_STAT_STICKYERR;
+            break;
+         case DP_CTRL_STAT:
+            dap.ctrlStat = (dap.ctrlStat&CTRL_STAT_STICKYERR)|(*data&CTRL_STAT_REQ_MASK);
+            // Power-up requests are acknowledged immediately
+            if (dap.ctrlStat&CTRL_STAT_CSYSPWRUPREQ)
+               dap.ctrlStat |= CTRL_STAT_CSYSPWRUPACK;
+            if (dap.ctrlStat&CTRL_STAT_CDBGPWRUPREQ)
+               dap.ctrlStat |= CTRL_STAT_CDBGPWRUPACK;
+            break;
+         case DP_SELECT_RESEND:
+            dap.select = *data;
+            break;
+      }
+   }
+   if ((ack == HOST_DAP_ACK_OK) && APnDP && RnW) {
+      dap.readBuffer = *data;
+   }
+   return ack;
+}
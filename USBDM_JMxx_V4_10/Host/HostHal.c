@@ -0,0 +1,70 @@
+/*! \file
+    \brief Hardware abstraction for the host-native build of the protocol core.
+
+    Port registers are plain memory.  The TPM counter runs in modelled time:
+    it advances by \ref HAL_TIMER_READ_TICKS on every read (so polling loops
+    terminate) and by the bit times charged by the target models.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "Common.h"
+#include "Configure.h"
+#include "BDMCommon.h"
+#include "USB.h"
+
+volatile HalReg_t halPortData[HAL_NUM_PORTS];
+volatile HalReg_t halPortDdr[HAL_NUM_PORTS];
+volatile HalReg_t halPortPe[HAL_NUM_PORTS];
+volatile uint8_t  halTpmSc;
+
+//! Modelled time since start in timer ticks (TIMER_FREQ)
+static uint64_t halTicks;
+
+//! Stack segment - only used by the stack size debug command.
+//! The host stack is elsewhere so the probe stops at the marker in the last byte.
+char __SEG_START_SSTACK[64] = {[63] = 0xFF};
+char __SEG_END_SSTACK[1];
+
+//! Advance modelled time
+//!
+//! @param ticks - time in timer ticks
+//!
+//! @note usbFrameCount follows the modelled time (1 frame/ms)
+//!
+void halTimerAdvance(uint32_t ticks) {
+   halTicks      += ticks;
+   usbFrameCount  = (U16)(halTicks/TIMER_MICROSECOND(1000));
+}
+
+//! Read TPMxCNT
+//!
+//! @return 16-bit counter value
+//!
+uint16_t halTimerRead(void) {
+   halTimerAdvance(HAL_TIMER_READ_TICKS);
+   return (uint16_t)halTicks;
+}
+
+//! Modelled time since start
+//!
+//! @return time in timer ticks
+//!
+uint64_t halTimerElapsed(void) {
+   return halTicks;
+}
+
+//! Software reset of the BDM (reset())
+//!
+//! The host build can't reboot - e.g. CMD_USBDM_ICP_BOOT
+//!
+void halReset(void) {
+   fprintf(stderr, "halReset() - BDM reset requested, exiting\n");
+   exit(EXIT_FAILURE);
+}
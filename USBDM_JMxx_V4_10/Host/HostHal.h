@@ -0,0 +1,97 @@
+/*! \file
+    \brief Hardware abstraction for the host-native build of the protocol core.
+
+    Stands in for the CodeWarrior device header (mc9s08jm60.h) when the
+    command processing code is compiled for the development host
+    (TARGET_HARDWARE == H_USBDM_HOST, see Configure/USBDM_Host.h).
+
+    Only the registers used by the host configuration are provided.  Port
+    registers are plain memory and the TPM counter is the modelled time of
+    the target models rather than a free-running clock.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#ifndef _HOSTHAL_H_
+#define _HOSTHAL_H_
+
+#include <stdint.h>
+#include <string.h>
+
+//=================================================================================
+// CPU control - the host build is single threaded and has no interrupts
+//
+#define interrupt                        //!< ISRs are plain functions
+#define disableInterrupts()   ((void)0)  //!< Disable all interrupts
+#define enableInterrupts()    ((void)0)  //!< Enable interrupts
+#define backgroundDebugMode() ((void)0)  //!< Enter Background Debug Mode if enabled
+#define wait()                ((void)0)  //!< Enter WAIT mode if enabled
+#define stop()                ((void)0)  //!< Enter STOP mode if enabled
+#define reset()               halReset() //!< Force reset
+
+//=================================================================================
+// Port registers
+//
+//! An 8-bit port register with bit access (bit 0 is LSB as on the HCS08)
+typedef union {
+   uint8_t Byte;
+   struct {
+      uint8_t b0:1, b1:1, b2:1, b3:1, b4:1, b5:1, b6:1, b7:1;
+   } Bits;
+} HalReg_t;
+
+//! Port indices for halPortData[] & halPortDdr[]
+enum {HAL_PTA, HAL_PTB, HAL_PTC, HAL_PTD, HAL_PTE, HAL_PTF, HAL_PTG, HAL_NUM_PORTS};
+
+extern volatile HalReg_t halPortData[HAL_NUM_PORTS]; //!< PTxD  - port data
+extern volatile HalReg_t halPortDdr[HAL_NUM_PORTS];  //!< PTxDD - port direction
+extern volatile HalReg_t halPortPe[HAL_NUM_PORTS];   //!< PTxPE - port pull-up enable
+
+#define PTAD_PTAD2       halPortData[HAL_PTA].Bits.b2
+#define PTADD_PTADD2     halPortDdr[HAL_PTA].Bits.b2
+#define PTBD_PTBD0       halPortData[HAL_PTB].Bits.b0
+#define PTBDD_PTBDD0     halPortDdr[HAL_PTB].Bits.b0
+#define PTCD_PTCD4       halPortData[HAL_PTC].Bits.b4
+#define PTCDD_PTCDD4     halPortDdr[HAL_PTC].Bits.b4
+#define PTED_PTED3       halPortData[HAL_PTE].Bits.b3
+#define PTEDD_PTEDD3     halPortDdr[HAL_PTE].Bits.b3
+#define PTED_PTED7       halPortData[HAL_PTE].Bits.b7
+#define PTEDD_PTEDD7     halPortDdr[HAL_PTE].Bits.b7
+#define PTFD_PTFD4       halPortData[HAL_PTF].Bits.b4
+#define PTFDD_PTFDD4     halPortDdr[HAL_PTF].Bits.b4
+#define PTGD             halPortData[HAL_PTG].Byte
+#define PTGDD            halPortDdr[HAL_PTG].Byte
+#define PTGD_PTGD2       halPortData[HAL_PTG].Bits.b2
+#define PTGDD_PTGDD2     halPortDdr[HAL_PTG].Bits.b2
+#define PTGPE_PTGPE2     halPortPe[HAL_PTG].Bits.b2
+#define PTGD_PTGD0_MASK  (1<<0)
+#define PTGD_PTGD1_MASK  (1<<1)
+
+//=================================================================================
+// Timer (TPM1)
+//
+//! The counter runs at TIMER_FREQ in modelled time.
+//! Each read advances it by HAL_TIMER_READ_TICKS so polling loops terminate.
+#define HAL_TIMER_READ_TICKS (24)
+
+extern volatile uint8_t halTpmSc;   //!< TPM1SC
+
+#define TPM1SC              halTpmSc
+#define TPM1SC_CLKSA_MASK   (1<<3)
+#define TPM1CNT             halTimerRead()
+
+uint16_t halTimerRead(void);
+void     halTimerAdvance(uint32_t ticks);
+uint64_t halTimerElapsed(void);
+
+void     halReset(void);
+
+//! Called by the pin macros (Configure/USBDM_Host.h) when BKPT or RESET change.
+//! Implemented by the target models (Host/HostBDMCommon.c).
+void     halPinsChanged(void);
+
+#endif // _HOSTHAL_H_
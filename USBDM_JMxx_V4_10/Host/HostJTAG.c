@@ -0,0 +1,313 @@
+/*! \file
+    \brief Host-native replacement for JTAG.c - TAP model with an ARM JTAG-DP
+
+    Models a single TAP (4-bit IR) in front of the DAP model (HostDAP.c):
+    - IDCODE (0xE) - 32-bit IDCODE
+    - ABORT  (0x8) - 35-bit DP ABORT
+    - DPACC  (0xA) - 35-bit DP access
+    - APACC  (0xB) - 35-bit AP access
+    - others       - 1-bit BYPASS
+
+    DPACC/APACC scans are {data[31:0], A[3:2], RnW}.  The capture value is the
+    result of the previous access {ReadResult[31:0], ACK[2:0]} (OK = 0b010).
+
+    Header & trailer bits (jtag_set_hdr() etc) are clocked but belong to other
+    devices on the chain so do not reach the modelled TAP.
+
+    Wire cost is one bit per TCK as in the bit-banged version of JTAG.c.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDM.h"
+#include "BDM_CF.h"
+#include "CmdProcessing.h"
+#include "BDMCommon.h"
+#include "SPI.h"
+#include "JTAGSequence.h"
+#include "HostModel.h"
+
+// Instructions
+#define JTAG_IR_LENGTH        (4)
+#define JTAG_IR_CAPTURE       (0x1)
+#define JTAG_IR_ABORT         (0x8)
+#define JTAG_IR_DPACC         (0xA)
+#define JTAG_IR_APACC         (0xB)
+#define JTAG_IR_IDCODE        (0xE)
+#define JTAG_IR_BYPASS        (0xF)
+
+#define JTAG_DPACC_LENGTH     (35)
+#define JTAG_IDCODE_LENGTH    (32)
+
+#define JTAG_ACK_OK           (0x2)  //!< OK/FAULT
+#define JTAG_ACK_WAIT         (0x1)  //!< WAIT
+
+//! TAP states of interest
+typedef enum {
+   TAP_IDLE,      //!< TEST-LOGIC-RESET or RUN-TEST/IDLE
+   TAP_SHIFT_DR,  //!< SHIFT-DR
+   TAP_SHIFT_IR,  //!< SHIFT-IR
+} TapState_t;
+
+//! State of the modelled TAP
+static struct {
+   TapState_t state;      //!< Current TAP state
+   U8         ir;         //!< Instruction register
+   uint64_t   shift;      //!< Shift register (IR or DR)
+   U8         length;     //!< Length of shift register
+   U32        result;     //!< Result of last DP/AP access
+   U8         ack;        //!< ACK of last DP/AP access
+} tap;
+
+static U16 dataRegisterHeader         = 0;
+static U16 dataRegisterTrailer        = 0;
+static U16 instructionRegisterHeader  = 0;
+static U16 instructionRegisterTrailer = 0;
+
+//! Reset the modelled TAP (TRST/power-on)
+//!
+void hostJtagReset(void) {
+   tap.state  = TAP_IDLE;
+   tap.ir     = JTAG_IR_IDCODE;
+   tap.shift  = 0;
+   tap.length = 1;
+   tap.result = 0;
+   tap.ack    = JTAG_ACK_OK;
+}
+
+//! Clock TCK
+//!
+static void jtagClock(U16 clocks) {
+   hostWireCharge(clocks, hostSpiBitTicks());
+}
+
+//! Capture-DR/IR on entering a shift state
+//!
+static void tapCapture(TapState_t state) {
+   tap.state = state;
+   if (state == TAP_SHIFT_IR) {
+      tap.shift  = JTAG_IR_CAPTURE;
+      tap.length = JTAG_IR_LENGTH;
+      return;
+   }
+   switch (tap.ir) {
+      case JTAG_IR_IDCODE:
+         tap.shift  = HOST_DAP_JTAG_IDCODE;
+         tap.length = JTAG_IDCODE_LENGTH;
+         break;
+      case JTAG_IR_DPACC:
+      case JTAG_IR_APACC:
+      case JTAG_IR_ABORT:
+         tap.shift  = ((uint64_t)tap.result<<3)|tap.ack;
+         tap.length = JTAG_DPACC_LENGTH;
+         break;
+      default:
+         tap.shift  = 0;
+         tap.length = 1;
+         break;
+   }
+}
+
+//! Update-DR/IR on leaving a shift state
+//!
+static void tapUpdate(void) {
+U32 data;
+U8  RnW;
+U8  regAddr;
+
+   if (tap.state == TAP_SHIFT_IR) {
+      tap.ir = (U8)(tap.shift&((1<<JTAG_IR_LENGTH)-1));
+      return;
+   }
+   if ((tap.ir != JTAG_IR_DPACC) && (tap.ir != JTAG_IR_APACC) && (tap.ir != JTAG_IR_ABORT)) {
+      return;
+   }
+   RnW     = (U8)(tap.shift&0x1);
+   regAddr = (U8)((tap.shift<<1)&0x0C);
+   data    = (U32)(tap.shift>>3);
+   if (tap.ir == JTAG_IR_ABORT) {
+      RnW     = 0;
+      regAddr = 0;
+   }
+   // FAULT is not reported by the JTAG-DP - only STICKYERR is set
+   (void)hostDapAccess(tap.ir == JTAG_IR_APACC, RnW, regAddr, &data);
+   tap.ack = JTAG_ACK_OK;
+   if (RnW) {
+      tap.result = data;
+   }
+}
+
+//! Shift bits through the TAP & carry out exit action
+//!
+//! @param options  - exit action & fill (see \ref JTAG_EXIT_ACTION_MASK)
+//! @param bitCount - # of bits
+//! @param writePtr - bits to shift in (NULL => fill from options)
+//! @param readPtr  - buffer for bits shifted out (NULL => discard)
+//!
+//! @note Buffers hold the first bit in the LSB of the LAST byte
+//!
+static void tapScan(U8 options, U8 bitCount, const U8 *writePtr, U8 *readPtr) {
+U16 trailer = (tap.state == TAP_SHIFT_IR)?instructionRegisterTrailer:dataRegisterTrailer;
+U8  numBytes = (bitCount+7)>>3;
+U8  readBuff[32];
+U8  bitNum;
+U8  inBit;
+U8  outBit;
+
+   hostWire.transfers++;
+
+   (void)memset(readBuff, 0, numBytes);
+   for (bitNum=0; bitNum<bitCount; bitNum++) {
+      if (writePtr != NULL)
+         inBit = (writePtr[numBytes-1-(bitNum>>3)]>>(bitNum&7))&0x01;
+      else
+         inBit = (options&JTAG_WRITE_1)?1:0;
+      outBit    = (U8)(tap.shift&0x01);
+      tap.shift = (tap.shift>>1)|((uint64_t)inBit<<(tap.length-1));
+      readBuff[numBytes-1-(bitNum>>3)] |= outBit<<(bitNum&7);
+   }
+   if (readPtr != NULL) {
+      (void)memcpy(readPtr, readBuff, numBytes);
+   }
+   switch (options&JTAG_EXIT_ACTION_MASK) {
+      case JTAG_STAY_SHIFT:
+         jtagClock(bitCount);
+         break;
+      case JTAG_EXIT_IDLE:
+         jtagClock(bitCount-1+trailer+3);
+         tapUpdate();
+         tap.state = TAP_IDLE;
+         break;
+      case JTAG_EXIT_SHIFT_DR:
+         jtagClock(bitCount-1+trailer+5);
+         tapUpdate();
+         tapCapture(TAP_SHIFT_DR);
+         break;
+      case JTAG_EXIT_SHIFT_IR:
+         jtagClock(bitCount-1+trailer+6);
+         tapUpdate();
+         tapCapture(TAP_SHIFT_IR);
+         break;
+   }
+}
+
+//=========================================================================
+// JTAG interface - as JTAG.c
+//
+//=========================================================================
+
+void jtag_set_hdr(U16 value) {
+   dataRegisterHeader = value;
+}
+
+void jtag_set_hir(U16 value) {
+   instructionRegisterHeader = value;
+}
+
+void jtag_set_tdr(U16 value) {
+   dataRegisterTrailer = value;
+}
+
+void jtag_set_tir(U16 value) {
+   instructionRegisterTrailer = value;
+}
+
+//!  Sets the JTAG hardware interface to an idle condition
+//!
+void jtag_interfaceIdle(void) {
+   RESET_3STATE();
+   TA_3STATE();
+   TRST_3STATE();
+}
+
+//! Initialises the JTAG Interface
+//!
+void jtag_init(void) {
+   (void)initJTAGSequence();
+   jtag_interfaceIdle();
+   (void)spi_setSpeed(0);
+}
+
+//! Turns off the JTAG interface
+//!
+void jtag_off(void) {
+   jtag_interfaceIdle();
+}
+
+//! Transitions the TAP controller to TEST-LOGIC-RESET state
+//! Makes no assumptions about initial TAP state
+//!
+void jtag_transition_reset(void) {
+   jtagClock(7);   // TMS = 1,1,1,1,1,1,1
+   tap.state = TAP_IDLE;
+   tap.ir    = JTAG_IR_IDCODE;
+}
+
+//! Transitions the TAP controller to SHIFT-DR or SHIFT-IR state
+//! Assumes TAP is in TEST-LOGIC-RESET or RUN-TEST/IDLE
+//!
+//! @param mode  \ref JTAG_SHIFT_DR => TAP controller is moved to SHIFT-DR \n
+//!              \ref JTAG_SHIFT_IR => TAP controller is moved to SHIFT-IR
+//!
+void jtag_transition_shift(U8 mode) {
+   if (mode == JTAG_SHIFT_IR) {
+      jtagClock(5+instructionRegisterHeader);   // TMS = 0,1,1,0,0
+      tapCapture(TAP_SHIFT_IR);
+   }
+   else {
+      jtagClock(4+dataRegisterHeader);          // TMS = 0,1,0,0
+      tapCapture(TAP_SHIFT_DR);
+   }
+}
+
+//! Writes given bit stream into data/instruction path of the JTAG
+//!
+//! @param options \ref JTAG_STAY_SHIFT    => leave the TAP state unchanged [SHIFT-DR or SHIFT-IR]  \n
+//!                \ref JTAG_EXIT_SHIFT_DR => leave the TAP in SHIFT-DR                             \n
+//!                \ref JTAG_EXIT_SHIFT_IR => leave the TAP in SHIFT-IR                             \n
+//!                \ref JTAG_EXIT_IDLE     => leave the TAP in RUN-TEST/IDLE
+//! @param bitCount   => specifies the number of bits to write [>0]
+//! @param writePtr   => pointer to block of data
+//! @note  Data are transmitted starting with LSB of the LAST byte in the supplied buffer
+//!
+void jtag_write(U8 options, U8 bitCount, const U8 *writePtr) {
+   tapScan(options, bitCount, writePtr, NULL);
+}
+
+//! Reads bitstream out of JTAG
+//!
+//! @param options \ref JTAG_STAY_SHIFT    => leave the TAP state unchanged [SHIFT-DR or SHIFT-IR]  \n
+//!                \ref JTAG_EXIT_SHIFT_DR => leave the TAP in SHIFT-DR                             \n
+//!                \ref JTAG_EXIT_SHIFT_IR => leave the TAP in SHIFT-IR                             \n
+//!                \ref JTAG_EXIT_IDLE     => leave the TAP in RUN-TEST/IDLE                        \n
+//!                + \ref JTAG_WRITE_1     => write 1's while reading
+//!                + \ref JTAG_WRITE_0     => write 0's while reading
+//! @param bitCount   => specifies the number of bits to read [>0]
+//! @param readPtr    => pointer to buffer for data
+//! @note  Data are stored starting with LSB of the LAST byte in the supplied buffer
+//!
+void jtag_read(U8 options, U8 bitCount, U8 *readPtr) {
+   tapScan(options, bitCount, NULL, readPtr);
+}
+
+//! Reads & writes bitstream through JTAG
+//!
+//! @param options   \ref JTAG_STAY_SHIFT    => leave the TAP state unchanged [SHIFT-DR or SHIFT-IR] \n
+//!                  \ref JTAG_EXIT_SHIFT_DR => leave the TAP in SHIFT-DR                            \n
+//!                  \ref JTAG_EXIT_SHIFT_IR => leave the TAP in SHIFT-IR                            \n
+//!                  \ref JTAG_EXIT_IDLE     => leave the TAP in RUN-TEST/IDLE
+//! @param bitCount   => specifies the number of bits to read/write [>0]
+//! @param writePtr   => pointer to block of data
+//! @param readPtr    => pointer to buffer for data (may be the same as writePtr)
+//! @note  Data are stored starting with LSB of the LAST byte in the supplied buffer
+//!
+void jtag_read_write(U8 options, U8 bitCount, const U8 *writePtr, U8 *readPtr) {
+   tapScan(options, bitCount, writePtr, readPtr);
+}
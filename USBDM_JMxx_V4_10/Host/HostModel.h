@@ -0,0 +1,83 @@
+/*! \file
+    \brief In-memory target models for the host-native build.
+
+    The models replace the pin-level drivers (BDM.c, BDM_CF.c, SWD.c & JTAG.c)
+    at the level the command processing code calls them:
+    - HCS08          - BDM_CMD_xx() & bdm_xx()
+    - Coldfire V2-4  - bdmcf_xx() (17-bit packets)
+    - ARM-SWD        - swd_xx()   (DP & MEM-AP)
+    - JTAG/ARM-JTAG  - jtag_xx()  (TAP with an ARM JTAG-DP)
+
+    Each model charges the bits it would put on the wire to \ref hostWire and
+    advances the modelled timer (TPMCNT) by the matching bit time.
+
+    All targets share one 64K memory.  Addresses are truncated to 16 bits.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#ifndef _HOSTMODEL_H_
+#define _HOSTMODEL_H_
+
+#include "Common.h"
+
+//! Wire activity accumulated by the target models
+typedef struct {
+   uint64_t bits;       //!< Bits (clock periods) on the debug interface
+   uint64_t transfers;  //!< Interface transactions (BDM commands, CF packets, SWD/JTAG-DP accesses, JTAG scans)
+   uint64_t syncs;      //!< BDM SYNC measurements (HCS08/HC12)
+} HostWireStats_t;
+
+extern HostWireStats_t hostWire;
+extern uint64_t        hostAbortAtBits; //!< Abort command when hostWire.bits reaches this (0 => never)
+
+void hostWireCharge(U16 bitCount, U16 bitTicks);
+U16  hostSpiBitTicks(void);
+
+//=================================================================================
+// Target memory (shared by all models)
+//
+#define HOST_MEMORY_SIZE  (0x10000UL)
+#define HOST_MEM(addr)    hostMemory[(U16)(addr)]
+
+extern U8 hostMemory[HOST_MEMORY_SIZE];
+
+//=================================================================================
+// Model control
+//
+void hostModelReset(void);
+void hostHcs08Reset(U8 mode);
+void hostHcs08Halt(void);
+void hostCfReset(U8 mode);
+void hostCfHalt(void);
+void hostDapReset(void);
+void hostJtagReset(void);
+
+//=================================================================================
+// HC12 without SYNC (speed found by bdmHC12_alt_speed_detect())
+//
+#define HOST_HC12_MAX_TRIED (64)
+
+extern U16      hostHc12SpeedsTried[HOST_HC12_MAX_TRIED]; //!< Distinct speeds (sync_length) tried in order
+extern unsigned hostHc12NumTried;
+
+void hostHc12Target(U32 busFrequency, U16 partid);
+
+//=================================================================================
+// ARM Debug Access Port (shared by ARM-SWD & ARM-JTAG)
+//
+#define HOST_DAP_ACK_OK     (1)  //!< OK response (SWD encoding)
+#define HOST_DAP_ACK_WAIT   (2)  //!< WAIT response (SWD encoding)
+#define HOST_DAP_ACK_FAULT  (4)  //!< FAULT response (SWD encoding)
+
+#define HOST_DAP_SWD_IDCODE  (0x2BA01477UL) //!< SW-DP IDCODE
+#define HOST_DAP_JTAG_IDCODE (0x4BA00477UL) //!< JTAG-DP IDCODE
+
+U8  hostDapAccess(U8 APnDP, U8 RnW, U8 regAddr, U32 *data);
+U32 hostDapReadBuffer(void);
+
+#endif // _HOSTMODEL_H_
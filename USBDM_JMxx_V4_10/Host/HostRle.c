@@ -0,0 +1,96 @@
+/*! \file
+    \brief Host side of the run-length encoding, see HostRle.h
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "HostRle.h"
+
+//! Decode run-length encoded data
+//!
+//! @param in      - encoded data
+//! @param inSize  - # of bytes of encoded data
+//! @param out     - buffer for decoded data
+//! @param outSize - size of buffer
+//!
+//! @return # of bytes decoded, -1 => malformed or too large for buffer
+//!
+long hostRleDecode(const U8 *in, unsigned inSize, U8 *out, unsigned outSize) {
+unsigned inIndex  = 0;
+unsigned outIndex = 0;
+unsigned length;
+U8       control;
+
+   while (inIndex < inSize) {
+      control = in[inIndex++];
+      if (control < 0x80) {
+         length = control+1U;
+         if ((inIndex+length > inSize) || (outIndex+length > outSize))
+            return -1;
+         (void)memcpy(out+outIndex, in+inIndex, length);
+         inIndex += length;
+      }
+      else {
+         length = control-0x80U+RLE_MIN_RUN;
+         if ((inIndex+1 > inSize) || (outIndex+length > outSize))
+            return -1;
+         (void)memset(out+outIndex, in[inIndex++], length);
+      }
+      outIndex += length;
+   }
+   return (long)outIndex;
+}
+
+//! Run-length encode data
+//!
+//! @param in       - data to encode
+//! @param inSize   - # of bytes of data
+//! @param out      - buffer for encoded data
+//! @param outSize  - size of buffer (e.g. encoded data limit of CMD_USBDM_WRITE_MEM_RLE)
+//! @param consumed - # of input bytes encoded (limited by outSize)
+//!
+//! @return # of bytes of encoded data
+//!
+unsigned hostRleEncode(const U8 *in, unsigned inSize, U8 *out, unsigned outSize, unsigned *consumed) {
+unsigned inIndex  = 0;
+unsigned outIndex = 0;
+unsigned run;
+unsigned literal;
+
+   while (inIndex < inSize) {
+      for (run=1; (inIndex+run < inSize) && (run < RLE_MAX_RUN) && (in[inIndex+run] == in[inIndex]); run++) {
+      }
+      if (run >= RLE_MIN_RUN) {
+         if (outIndex+2 > outSize)
+            break;
+         out[outIndex++] = (U8)(0x80+run-RLE_MIN_RUN);
+         out[outIndex++] = in[inIndex];
+         inIndex += run;
+         continue;
+      }
+      // Literal up to the next run
+      for (literal=1; (inIndex+literal < inSize) && (literal < RLE_MAX_LITERAL); literal++) {
+         if ((inIndex+literal+2 < inSize) &&
+             (in[inIndex+literal] == in[inIndex+literal+1]) &&
+             (in[inIndex+literal] == in[inIndex+literal+2]))
+            break;
+      }
+      if (outIndex+1+literal > outSize)
+         literal = (outSize > outIndex+1)?outSize-outIndex-1:0;
+      if (literal == 0)
+         break;
+      out[outIndex++] = (U8)(literal-1);
+      (void)memcpy(out+outIndex, in+inIndex, literal);
+      outIndex += literal;
+      inIndex  += literal;
+   }
+   *consumed = inIndex;
+   return outIndex;
+}
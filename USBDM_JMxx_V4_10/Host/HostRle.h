@@ -0,0 +1,24 @@
+/*! \file
+    \brief Host side of the run-length encoding used by CMD_USBDM_READ_MEM_RLE
+           & CMD_USBDM_WRITE_MEM_RLE, see \ref RLE_Encoding
+
+    hostRleDecode() expands the data of a CMD_USBDM_READ_MEM_RLE response
+    ([3..N] of the response, [1..2] is the # of bytes it covers).
+    hostRleEncode() builds the data for CMD_USBDM_WRITE_MEM_RLE.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#ifndef _HOSTRLE_H_
+#define _HOSTRLE_H_
+
+#include "Common.h"
+
+long     hostRleDecode(const U8 *in, unsigned inSize, U8 *out, unsigned outSize);
+unsigned hostRleEncode(const U8 *in, unsigned inSize, U8 *out, unsigned outSize, unsigned *consumed);
+
+#endif // _HOSTRLE_H_
@@ -0,0 +1,252 @@
+/*! \file
+    \brief Host-native replacement for SWD.c - ARM-SWD interface to the DAP model
+
+    Each swd_readReg()/swd_writeReg() is one SWD transaction on the DAP model
+    (HostDAP.c).  AP reads are posted as on the wire - the value returned is
+    that of the previous AP read and the current value is left in RDBUFF.
+
+    Data buffers hold 32-bit values most significant byte first as in SWD.c.
+
+    Wire cost of each transaction (bits):
+    - 8 request, 1 turn-around, 3 acknowledge
+    - 33 data & parity, 1 turn-around and 8 idle
+    - FAULT/WAIT - 1 turn-around
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "SWD.h"
+#include "BDM.h"
+#include "BDM_CF.h"
+#include "CmdProcessing.h"
+#include "BDMCommon.h"
+#include "SPI.h"
+#include "TargetDefines.h"
+#include "HostModel.h"
+
+#define SWD_READ_IDCODE 0xA5 // (Park,Stop,Parity,A[32],R/W,AP/DP,Start) = 10100101
+
+// Masks for SWD_WR_DP_ABORT
+#define SWD_DP_ABORT_CLEAR_ERRORS_B3 0x1E
+
+#define SWD_WAIT_RETRY      (20)   //!< Number of times to retry on WAIT response
+
+#define SWD_HEADER_BITS     (8+1+3) //!< Request, turn-around & acknowledge
+#define SWD_DATA_BITS       (33+1+8)//!< Data & parity, turn-around & idle
+#define SWD_ERROR_BITS      (1)     //!< Turn-around after FAULT/WAIT
+
+//! Sets the SWD interface to an idle state
+//! RESET=3-state, SWCLK=High, SWDIO=3-state
+//!
+void swd_interfaceIdle(void) {
+   RESET_3STATE();
+   SWD_3STATE();
+}
+
+//! Initialise the SWD interface and sets it to an idle state
+//!
+void swd_init(void) {
+   (void)spi_setSpeed(0);
+   swd_interfaceIdle();
+}
+
+//! Transmits 8-bits of idle (SDIO=0)
+//!
+void swd_txIdle8(void) {
+   hostWireCharge(8, hostSpiBitTicks());
+}
+
+//! One SWD transaction
+//!
+//! @param command - SWD command byte (see SWD_RD_DP_IDCODE etc)
+//! @param data    - 32-bit value to write or value read (MSB first)
+//!
+//! @return \n
+//!    == \ref BDM_RC_OK              => Success        \n
+//!    == \ref BDM_RC_ARM_FAULT_ERROR => FAULT response from target \n
+//!    == \ref BDM_RC_ACK_TIMEOUT     => Excessive number of WAIT responses from target
+//!
+static U8 swd_transaction(U8 command, U8 *data) {
+U8  APnDP   = (command>>1)&0x01;
+U8  RnW     = (command>>2)&0x01;
+U8  regAddr = (command>>1)&0x0C;
+U8  retry   = SWD_WAIT_RETRY;
+U8  ack;
+U32 value   = 0;
+U32 posted  = hostDapReadBuffer();
+
+   if (!RnW) {
+      value = ((U32)data[0]<<24)|((U32)data[1]<<16)|((U32)data[2]<<8)|data[3];
+   }
+   do {
+      hostWire.transfers++;
+      hostWireCharge(SWD_HEADER_BITS, hostSpiBitTicks());
+      ack = hostDapAccess(APnDP, RnW, regAddr, &value);
+      if (ack == HOST_DAP_ACK_OK)
+         break;
+      hostWireCharge(SWD_ERROR_BITS, hostSpiBitTicks());
+   } while ((ack == HOST_DAP_ACK_WAIT) && (retry-- > 0));
+
+   switch (ack) {
+      case HOST_DAP_ACK_OK:    break;
+      case HOST_DAP_ACK_WAIT:  return BDM_RC_ACK_TIMEOUT;
+      case HOST_DAP_ACK_FAULT: return BDM_RC_ARM_FAULT_ERROR;
+      default:                 return BDM_RC_NO_CONNECTION;
+   }
+   hostWireCharge(SWD_DATA_BITS, hostSpiBitTicks());
+   if (RnW) {
+      if (APnDP) {
+         value = posted;   // AP reads are posted
+      }
+      data[0] = (U8)(value>>24);
+      data[1] = (U8)(value>>16);
+      data[2] = (U8)(value>>8);
+      data[3] = (U8)value;
+   }
+   return BDM_RC_OK;
+}
+
+//! SWD - Try to connect to the target
+//!
+//! This will do the following:
+//! - Switch the interface to SWD mode (64 1's, 0xE79E, 64 1's)
+//! - Read IDCODE
+//!
+//! @return \n
+//!    == \ref BDM_RC_OK              => Success        \n
+//!    == \ref BDM_RC_NO_CONNECTION   => Unexpected/no response from target
+//!
+U8 swd_connect(void) {
+   U8 buff[4];
+
+   hostWireCharge(64+16+64, hostSpiBitTicks());
+   swd_txIdle8();
+
+   // Target must respond to read IDCODE immediately
+   return swd_readReg(SWD_READ_IDCODE, buff);
+}
+
+//! Read SWD register
+//!
+//! @param command - SWD command byte to select register etc.
+//! @param data    - buffer for 32-bit value read
+//!
+//! @return \n
+//!    == \ref BDM_RC_OK               => Success        \n
+//!    == \ref BDM_RC_ARM_FAULT_ERROR  => FAULT response from target \n
+//!    == \ref BDM_RC_ACK_TIMEOUT      => Excessive number of WAIT responses from target \n
+//!    == \ref BDM_RC_NO_CONNECTION    => Unexpected/no response from target
+//!
+U8 swd_readReg(U8 command, U8 *data) {
+   return swd_transaction(command, data);
+}
+
+//! Write SWD register
+//!
+//! @param command - SWD command byte to select register etc.
+//! @param data    - buffer containing 32-bit value to write
+//!
+//! @return \n
+//!    == \ref BDM_RC_OK               => Success        \n
+//!    == \ref BDM_RC_ARM_FAULT_ERROR  => FAULT response from target \n
+//!    == \ref BDM_RC_ACK_TIMEOUT      => Excessive number of WAIT responses from target \n
+//!    == \ref BDM_RC_NO_CONNECTION    => Unexpected/no response from target
+//!
+U8 swd_writeReg(U8 command, const U8 *data) {
+   return swd_transaction(command, (U8 *)data);
+}
+
+//! Write AP register
+//!
+//! @param 16-bit address \n
+//!    A[15:8]  => DP-AP-SELECT[31:24] (AP # Select) \n
+//!    A[7:4]   => DP-AP-SELECT[7:4]   (Bank select within AP) \n
+//!    A[3:2]   => APACC[3:2]          (Register select within bank)
+//! @param buff \n
+//!   - [1..4]  =>  32-bit register value
+//!
+//! @return
+//!  == \ref BDM_RC_OK => success
+//!
+U8 swd_writeAPReg(const U8 *address, const U8 *buff) {
+   static const U8 writeAP[] = {SWD_WR_AP_REG0,   SWD_WR_AP_REG1,    SWD_WR_AP_REG2,   SWD_WR_AP_REG3};
+   U8 rc;
+   U8 regNo = writeAP[(address[1]&0xC)>>2];
+   U8 selectData[4];
+   selectData[0] = address[0];
+   selectData[1] = 0;
+   selectData[2] = 0;
+   selectData[3] = address[1]&0xF0;
+
+   // Set up SELECT register for AP access
+   rc = swd_writeReg(SWD_WR_DP_SELECT, selectData);
+   if (rc != BDM_RC_OK) {
+      return rc;
+   }
+   // Initiate write to AP register
+   rc = swd_writeReg(regNo, buff);
+   if (rc != BDM_RC_OK) {
+      return rc;
+   }
+   // Read from READBUFF register to allow stall/status response
+   rc = swd_readReg(SWD_RD_DP_RDBUFF, selectData);
+   return rc;
+}
+
+//! Read AP register
+//!
+//! @param 16-bit address \n
+//!    A[15:8]  => DP-AP-SELECT[31:24] (AP # Select) \n
+//!    A[7:4]   => DP-AP-SELECT[7:4]   (Bank select within AP) \n
+//!    A[3:2]   => APACC[3:2]          (Register select within bank)
+//! @param buff \n
+//!   - [1..4]  =>  32-bit register value
+//!
+//! @return
+//!  == \ref BDM_RC_OK => success
+//!
+U8 swd_readAPReg(const U8 *address, U8 *buff) {
+   static const U8 readAP[]  = {SWD_RD_AP_REG0,   SWD_RD_AP_REG1,    SWD_RD_AP_REG2,   SWD_RD_AP_REG3};
+   U8 rc;
+   U8 regNo = readAP[(address[1]&0xC)>>2];
+   U8 selectData[4];
+   selectData[0] = address[0];
+   selectData[1] = 0;
+   selectData[2] = 0;
+   selectData[3] = address[1]&0xF0;
+
+   // Set up SELECT register for AP access
+   rc = swd_writeReg(SWD_WR_DP_SELECT, selectData);
+   if (rc != BDM_RC_OK) {
+      return rc;
+   }
+   // Initiate read from AP register (dummy data)
+   rc = swd_readReg(regNo, buff);
+   if (rc != BDM_RC_OK) {
+      return rc;
+   }
+   // Read from READBUFF register
+   rc = swd_readReg(SWD_RD_DP_RDBUFF, buff);
+   return rc;
+}
+
+//! ARM-SWD - check  &clear stick bits
+//!
+//! @return error code
+//!
+U8 swd_clearStickyError(void) {
+   static const U8 swdClearErrors[4] = {0,0,0,SWD_DP_ABORT_CLEAR_ERRORS_B3};
+   return swd_writeReg(SWD_WR_DP_ABORT, swdClearErrors);
+}
+
+U8 swd_test(void) {
+
+   return swd_connect();
+}
@@ -0,0 +1,171 @@
+/*! \file
+    \brief USB replacement for the host-native build.
+
+    See HostUSB.h.  The response status (bit 7 is the command toggle) is
+    checked and counted.  The response to the last command is kept in
+    \ref hostUsbResponse for the tests.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "USB.h"
+#include "HostUSB.h"
+
+volatile U16 usbFrameCount;
+
+HostUsbStats_t hostUsb;
+U8             hostUsbTrace = FALSE;
+U8             hostUsbResponse[HOST_USB_RESPONSE_SIZE];
+uint32_t       hostUsbResponseSize;
+
+static const U8 *recordPtr;      //!< Next command record
+static const U8 *recordEnd;      //!< End of command records
+static jmp_buf  *recordExit;     //!< Where to go when the records are exhausted
+static U8        currentCommand; //!< Command being executed
+static U8        streamStarted;  //!< Status of streamed response not yet checked
+static uint32_t  streamBytes;    //!< Size of current streamed transfer
+static U8        streamLast;     //!< Last byte of current streamed transfer (final status)
+
+//! Records the status of a response
+//!
+static void checkStatus(U8 status) {
+   status &= 0x7F;
+   if (status == BDM_RC_OK)
+      return;
+   if (hostUsb.failures++ == 0) {
+      hostUsb.failIndex   = (uint32_t)(hostUsb.commands-1);
+      hostUsb.failCommand = currentCommand;
+      hostUsb.failStatus  = status;
+   }
+}
+
+//! Keep & print a response (or part of a streamed response)
+//!
+static void traceResponse(U8 size, const U8 *buffer) {
+U8 index;
+
+   if (hostUsbResponseSize+size <= HOST_USB_RESPONSE_SIZE) {
+      (void)memcpy(hostUsbResponse+hostUsbResponseSize, buffer, size);
+      hostUsbResponseSize += size;
+   }
+   if (!hostUsbTrace)
+      return;
+   printf("%5u %3u:", (unsigned)hostUsb.commands, currentCommand);
+   for (index=0; index<size; index++) {
+      printf(" %02X", buffer[index]);
+   }
+   printf("\n");
+}
+
+//! Start command processing from a buffer of command records
+//!
+//! @param records      - command records
+//! @param length       - size of records in bytes
+//! @param endOfRecords - longjmp() target when the records are exhausted
+//!
+void hostUsbStart(const U8 *records, uint32_t length, jmp_buf *endOfRecords) {
+   (void)memset(&hostUsb, 0, sizeof(hostUsb));
+   recordPtr  = records;
+   recordEnd  = records+length;
+   recordExit = endOfRecords;
+}
+
+//! Get the next command record
+//!
+//! @param size   - size of buffer
+//! @param buffer - buffer for command
+//!
+void receiveUSBCommand(U8 size, U8 *buffer) {
+U8 recordSize;
+
+   if (recordPtr >= recordEnd) {
+      longjmp(*recordExit, 1);
+   }
+   recordSize = recordPtr[0];
+   if ((recordSize < 2) || (recordSize > size) || (recordPtr+recordSize > recordEnd)) {
+      fprintf(stderr, "receiveUSBCommand() - illegal record size %d\n", recordSize);
+      exit(EXIT_FAILURE);
+   }
+   (void)memcpy(buffer, recordPtr, recordSize);
+   recordPtr += recordSize;
+   currentCommand = buffer[1]&0x7F;
+   hostUsb.commands++;
+   hostUsbResponseSize = 0;
+}
+
+//! Return a command response
+//!
+//! @param size   - size of response
+//! @param buffer - response, [0] = status
+//!
+void sendUSBResponse(U8 size, const U8 *buffer) {
+   hostUsb.responseBytes += size;
+   checkStatus(buffer[0]);
+   traceResponse(size, buffer);
+}
+
+//! Start a streamed IN transfer
+//!
+void startUSBStream(U8 *ringBuffer, U8 numSlots) {
+   (void)ringBuffer;
+   (void)numSlots;
+   streamStarted = TRUE;
+   streamBytes   = 0;
+}
+
+//! Add data to a streamed IN transfer
+//!
+//! @note The first byte of the stream is the response status
+//!
+void putUSBStream(U8 size, const U8 *buffer) {
+   if (streamStarted && (size > 0)) {
+      streamStarted = FALSE;
+      checkStatus(buffer[0]);
+   }
+   if (size > 0)
+      streamLast = buffer[size-1];
+   hostUsb.responseBytes += size;
+   streamBytes           += size;
+   traceResponse(size, buffer);
+}
+
+//! Complete a streamed IN transfer
+//!
+//! @note The last byte of the stream is the final status
+//!
+void endUSBStream(void) {
+   if (streamBytes > 1)
+      checkStatus(streamLast);
+   streamStarted = FALSE;
+   hostUsb.streamPackets += (streamBytes+USB_STREAM_PACKET_SIZE-1)/USB_STREAM_PACKET_SIZE;
+}
+
+//! Indicate the BDM is busy (EP0 polling) - nothing to do
+//!
+void setBDMBusy(void) {
+}
+
+//! Mask interrupts - the host build has none
+//!
+//! @return previous mask
+//!
+U8 saveAndDisableInterrupts(void) {
+   return 0;
+}
+
+//! Restore interrupt mask - the host build has none
+//!
+//! @param mask - mask from saveAndDisableInterrupts()
+//!
+void setInterrupts(U8 mask) {
+   (void)mask;
+}
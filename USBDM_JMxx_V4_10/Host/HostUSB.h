@@ -0,0 +1,45 @@
+/*! \file
+    \brief USB replacement for the host-native build.
+
+    Commands are taken from a buffer of pre-encoded command records rather
+    than EP0/EP1.  Each record is a command buffer as received by
+    commandLoop(): [0] = size of record, [1] = command, [2..] = parameters.
+
+    When the records are exhausted receiveUSBCommand() returns to the caller
+    of hostUsbStart() with longjmp() - commandLoop() never returns.
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#ifndef _HOSTUSB_H_
+#define _HOSTUSB_H_
+
+#include <setjmp.h>
+#include "Common.h"
+
+//! Responses returned by the command processing code
+typedef struct {
+   uint64_t commands;      //!< Commands received
+   uint64_t responseBytes; //!< Bytes returned (responses & streamed data)
+   uint64_t streamPackets; //!< Packets sent by streamed transfers
+   uint64_t failures;      //!< Responses with status other than BDM_RC_OK
+   uint32_t failIndex;     //!< Index of the first failing command in the records
+   U8       failCommand;   //!< Command code of the first failure
+   U8       failStatus;    //!< Status of the first failure
+} HostUsbStats_t;
+
+//! Size of \ref hostUsbResponse - largest streamed response plus a final status
+#define HOST_USB_RESPONSE_SIZE (0x10000UL+0x100)
+
+extern HostUsbStats_t hostUsb;
+extern U8             hostUsbTrace;  //!< Print each response on stdout
+extern U8             hostUsbResponse[HOST_USB_RESPONSE_SIZE]; //!< Response to the last command (all transfers)
+extern uint32_t       hostUsbResponseSize;                     //!< Size of \ref hostUsbResponse
+
+void hostUsbStart(const U8 *records, uint32_t length, jmp_buf *endOfRecords);
+
+#endif // _HOSTUSB_H_
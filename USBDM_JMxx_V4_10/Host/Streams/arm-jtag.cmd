@@ -0,0 +1,37 @@
+# ARM debug access over JTAG - raw TAP scans to the JTAG-DP & MEM-AP
+#
+# JTAG_WRITE/JTAG_READ_WRITE: [2] = exit action, [3] = # of bits, [4..] = data (first bit in LSB of last byte)
+#   exit action - 01 = RUN-TEST/IDLE, 02 = SHIFT-DR, 03 = SHIFT-IR
+# DPACC/APACC scans are 35 bits {data[31:0], A[3:2], RnW}, the value captured is {result[31:0], ACK[2:0]}
+#
+SET_TARGET 08                                 # T_ARM_JTAG
+JTAG_GOTORESET
+JTAG_GOTOSHIFT 00                             # SHIFT-DR
+JTAG_READ 01 20                               # IDCODE
+JTAG_EXECUTE_SEQUENCE 04 07 05 09 84 0E 04 60 00   # IR=IDCODE, read 32-bit DR
+
+# DPACC - power up & check CTRL/STAT
+JTAG_GOTOSHIFT 01                             # SHIFT-IR
+JTAG_WRITE 02 04 0A                           # IR=DPACC
+JTAG_WRITE 02 23 02 80 00 00 02               # CTRL/STAT <- 50000000
+JTAG_READ_WRITE 02 23 00 00 00 00 03          # Read CTRL/STAT
+JTAG_READ_WRITE 02 23 00 00 00 00 07          # Read RDBUFF => CTRL/STAT
+JTAG_WRITE 01 23 00 00 00 00 04               # SELECT <- 00000000 (AP#0, bank 0)
+
+# APACC - memory writes with auto-increment
+JTAG_GOTOSHIFT 01
+JTAG_WRITE 02 04 0B                           # IR=APACC
+JTAG_WRITE 02 23 01 18 00 02 90               # CSW <- 23000052
+JTAG_WRITE 02 23 01 00 00 20 02               # TAR <- 20000400
+32* JTAG_WRITE 02 23 00 91 A2 B3 C6           # DRW <- 12345678
+
+# APACC - memory reads (each read returns the previous result)
+JTAG_WRITE 02 23 01 00 00 20 02               # TAR <- 20000400
+33* JTAG_READ_WRITE 02 23 00 00 00 00 07      # DRW
+JTAG_WRITE 01 23 00 00 00 00 07               # DRW
+
+# DPACC - check for errors
+JTAG_GOTOSHIFT 01
+JTAG_WRITE 02 04 0A                           # IR=DPACC
+JTAG_READ_WRITE 02 23 00 00 00 00 03          # Read CTRL/STAT
+JTAG_READ_WRITE 01 23 00 00 00 00 07          # Read RDBUFF => CTRL/STAT
@@ -0,0 +1,52 @@
+# ARM Cortex-M debug session over SWD - DP/AP, core registers, memory & the extended memory commands
+#
+# DP/AP register numbers are in [2..3], register values in [4..7] (most significant byte first).
+# Memory data is in target (little-endian) byte order.
+#
+SET_TARGET 09                                 # T_ARM_SWD
+CONNECT
+WRITE_DREG 00 01 50 00 00 00                  # CTRL/STAT - CSYSPWRUPREQ|CDBGPWRUPREQ
+READ_DREG 00 01                               # CTRL/STAT
+READ_DREG 00 00                               # IDCODE
+READ_CREG 00 FC                               # AP#0 IDR
+WRITE_CREG 00 00 23 00 00 52                  # AP#0 CSW - word, auto-increment
+
+# Core registers
+TARGET_HALT
+WRITE_REG 00 00 12 34 56 78                   # R0
+WRITE_REG 00 0F 20 00 04 00                   # PC
+4* READ_REG 00 00
+READ_REG 00 0F
+READ_MEM 04 04 l:E000EDF0                     # DHCSR
+
+# Download
+8* WRITE_MEM 04 20 l:20000400 8*DE 8*AD 8*BE 8*EF
+WRITE_MEM 02 80 l:20000500 128*A5
+FILL_MEM 04 00 l:20000600 l:00000200 70 47 00 BF     # BX LR, NOP
+WRITE_MEM 01 04 l:20000080 11 22 33 44
+
+# Read back
+16* READ_MEM 04 40 l:20000400
+READ_MEM 01 04 l:20000080
+READ_MEM_STREAM 04 00 l:20000400 w:0400
+CRC_MEM 04 00 l:20000400 l:00000400
+VERIFY_MEM 04 20 l:20000400 00 8*DE 8*AD 8*BE 8*EF
+HASH_MEM 04 40 l:20000400 w:0010
+READ_MEM_RLE 04 00 l:20000400 w:0800
+READ_MEM_GATHER 03 04 08 l:20000400 02 08 l:20000500 04 08 l:20000600
+WRITE_MEM_RLE 04 00 l:20000800 w:0100 FD 00 FD 11      # 128*00 128*11
+MODIFY_MEM 01 00 l:20000080 l:000000F0 l:00000001
+POLL_MEM 01 00 l:20000080 l:000000FF l:00000011 w:000A
+
+# Run control with the read cache
+SET_READ_CACHE 03                             # READ_CACHE_ENABLE|READ_CACHE_HALTED
+4* READ_MEM 04 10 l:20000400
+TARGET_STEP
+READ_REG 00 0F
+TARGET_GO
+TARGET_HALT
+READ_REG 00 0F
+SET_READ_CACHE 00
+
+# Batch of small commands
+EXECUTE_BATCH 00 08 21 04 04 l:20000400 04 1B 00 00 04 1B 00 0F
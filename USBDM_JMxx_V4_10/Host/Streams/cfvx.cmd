@@ -0,0 +1,53 @@
+# Coldfire V2/3/4 debug session - reset, registers, memory & the extended memory commands
+#
+# Register numbers are in [3] (A/D & debug registers) or as a 16-bit value in [2..3]
+# (control registers).  Register & memory values are big-endian as on the target.
+#
+SET_TARGET 04                                 # T_CFVx
+TARGET_RESET 04                               # RESET_HARDWARE|RESET_SPECIAL
+CONNECT
+READ_STATUS_REG
+READ_DREG 00 00                               # CSR
+
+# Registers
+WRITE_REG 00 00 12 34 56 78                   # D0
+WRITE_REG 00 08 00 00 10 00                   # A0
+WRITE_CREG w:080F 00 00 04 00                 # PC
+WRITE_CREG w:080E 00 00 27 00                 # SR
+4* READ_REG 00 00
+READ_REG 00 08
+READ_CREG w:080F
+READ_CREG w:080E
+
+# Download
+8* WRITE_MEM 04 20 l:00000400 8*DE 8*AD 8*BE 8*EF
+WRITE_MEM 02 80 l:00000500 128*A5
+FILL_MEM 04 00 l:00000600 l:00000200 00 00 4E 71     # NOP
+WRITE_MEM 01 04 l:00000080 11 22 33 44
+
+# Read back
+16* READ_MEM 04 40 l:00000400
+READ_MEM 01 04 l:00000080
+READ_MEM_STREAM 04 00 l:00000400 w:0400
+CRC_MEM 04 00 l:00000400 l:00000400
+VERIFY_MEM 04 20 l:00000400 00 8*DE 8*AD 8*BE 8*EF
+HASH_MEM 04 40 l:00000400 w:0010
+READ_MEM_RLE 04 00 l:00000400 w:0800
+READ_MEM_GATHER 03 04 08 l:00000400 02 08 l:00000500 04 08 l:00000600
+WRITE_MEM_RLE 04 00 l:00000800 w:0100 FD 00 FD 11      # 128*00 128*11
+MODIFY_MEM 01 00 l:00000080 l:000000F0 l:00000001
+POLL_MEM 01 00 l:00000080 l:000000FF l:00000011 w:000A
+
+# Run control with the read cache
+SET_READ_CACHE 03                             # READ_CACHE_ENABLE|READ_CACHE_HALTED
+4* READ_MEM 04 10 l:00000400
+TARGET_STEP
+READ_CREG w:080F
+TARGET_GO
+TARGET_HALT
+READ_STATUS_REG
+READ_CREG w:080F
+SET_READ_CACHE 00
+
+# Batch of small commands
+EXECUTE_BATCH 00 08 21 04 04 l:00000400 04 1B 00 00 04 1B 00 08
@@ -0,0 +1,48 @@
+# HCS08 debug session - connect, registers, memory & the extended memory commands
+#
+# Memory commands: [2] = element size, [3] = count, [4..7] = address, data ...
+#
+SET_TARGET 01                                 # T_HCS08
+CONNECT
+TARGET_RESET 08                               # RESET_SOFTWARE|RESET_SPECIAL
+READ_STATUS_REG
+GET_SPEED
+
+# Registers: [3] = register, [6..7] = value
+WRITE_REG 00 0B 00 00 w:1000                  # PC
+WRITE_REG 00 0C 00 00 w:0080                  # HX
+WRITE_REG 00 08 00 00 w:0055                  # A
+4* READ_REG 00 0B
+READ_REG 00 0C
+READ_REG 00 08
+READ_REG 00 0F                                # SP
+
+# Download
+8* WRITE_MEM 01 20 l:00000100 32*5A
+WRITE_MEM 01 80 l:00000200 128*A5
+FILL_MEM 01 00 l:00000300 l:00000400 l:000000EE
+
+# Read back
+16* READ_MEM 01 40 l:00000100
+READ_MEM_STREAM 01 00 l:00000100 w:0400
+CRC_MEM 01 00 l:00000100 l:00000600
+VERIFY_MEM 01 20 l:00000100 00 32*5A
+HASH_MEM 01 40 l:00000100 w:0010
+READ_MEM_RLE 01 00 l:00000100 w:0800
+READ_MEM_GATHER 03 01 08 l:00000100 01 08 l:00000200 01 08 l:00000300
+WRITE_MEM_RLE 01 00 l:00000800 w:0100 FD 00 FD 11      # 128*00 128*11
+MODIFY_MEM 01 00 l:00000080 l:000000F0 l:00000001
+POLL_MEM 01 00 l:00000080 l:000000FF l:000000F1 w:000A
+
+# Run control with the read cache
+SET_READ_CACHE 03                             # READ_CACHE_ENABLE|READ_CACHE_HALTED
+4* READ_MEM 01 10 l:00000100
+TARGET_STEP
+READ_REG 00 0B
+TARGET_GO
+TARGET_HALT
+READ_STATUS_REG
+SET_READ_CACHE 00
+
+# Batch of small commands
+EXECUTE_BATCH 00 08 21 01 04 l:00000100 04 1B 00 0B 04 1B 00 0C
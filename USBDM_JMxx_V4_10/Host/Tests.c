@@ -0,0 +1,1698 @@
+/*! \file
+    \brief Data checking tests for the host-native build.
+
+    Each test sends commands through commandLoop() to the in-memory target
+    models (HCS08 unless noted) and checks the responses against the model
+    memory or an independent host-side calculation.
+
+    Usage: usbdm-tests test ... [srec file ...]  (run by ctest, see CMakeLists.txt)
+    - crc     - CMD_USBDM_CRC_MEM against a bitwise zlib crc32()
+    - rle     - CMD_USBDM_READ_MEM_RLE decoded & CMD_USBDM_WRITE_MEM_RLE of encoded data
+    - batch   - CMD_USBDM_EXECUTE_BATCH results byte-identical to individual commands
+    - cache   - read cache never returns stale data
+    - sync    - SYNC only when the speed may have changed
+    - speed   - HC12 speed guessing tries learned speeds first (MRU)
+    - verify  - CMD_USBDM_VERIFY_MEM edge cases
+    - poll    - CMD_USBDM_POLL_MEM edge cases
+    - gather  - CMD_USBDM_READ_MEM_GATHER edge cases
+    - events  - halt of BDM target found while idle is reported in target events
+    - txtiming - BDM Tx routines (from BDM.c) keep BKGD within the BDC bit window
+    - chunks  - multi-chunk memory commands check alignment, report progress & stop on abort
+    - stream  - CMD_USBDM_READ_MEM_STREAM data & final status
+    - srec    - READ_MEM_RLE/WRITE_MEM_RLE round trip of S-record images (files follow)
+
+    \verbatim
+    Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Created                                                                  V4.10
+   +=======================================================================================
+   \endverbatim
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDM.h"
+#include "CmdProcessing.h"
+#include "BDMCommon.h"
+#include "HostModel.h"
+#include "HostUSB.h"
+#include "HostRle.h"
+
+static unsigned failures;
+
+//! Report a failed check
+//!
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+static void check(int ok, const char *condition, int line) {
+   if (!ok) {
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, line, condition);
+      failures++;
+   }
+}
+
+//=========================================================================
+// Command construction & execution
+//
+//=========================================================================
+
+static U8 cmd[MAX_COMMAND_SIZE];  //!< Command being built, [0] = size
+
+static void cmdStart(U8 command) {
+   cmd[0] = 2;
+   cmd[1] = command;
+}
+
+static void cmdData(const void *data, unsigned size) {
+   if (cmd[0]+size > MAX_COMMAND_SIZE) {
+      fprintf(stderr, "Command too large\n");
+      exit(EXIT_FAILURE);
+   }
+   (void)memcpy(cmd+cmd[0], data, size);
+   cmd[0] += (U8)size;
+}
+
+static void cmdU8(U8 value) {
+   cmdData(&value, sizeof(value));
+}
+
+static void cmdU16(U16 value) {
+   cmdData(&value, sizeof(value));
+}
+
+static void cmdU32(U32 value) {
+   cmdData(&value, sizeof(value));
+}
+
+//! Execute the command
+//!
+//! @return status, response is in hostUsbResponse
+//!
+static U8 cmdRun(void) {
+jmp_buf endOfRecords;
+
+   hostUsbStart(cmd, cmd[0], &endOfRecords);
+   if (setjmp(endOfRecords) == 0) {
+      commandLoop();
+   }
+   return hostUsbResponse[0]&0x7F;
+}
+
+//! Reset the modelled HCS08 into active background mode & connect
+//!
+static void startHcs08(void) {
+   hostModelReset();
+   cmdStart(CMD_USBDM_SET_TARGET);
+   cmdU8(T_HCS08);
+   CHECK(cmdRun() == BDM_RC_OK);
+   cmdStart(CMD_USBDM_TARGET_RESET);
+   cmdU8(RESET_SPECIAL|RESET_SOFTWARE);
+   CHECK(cmdRun() == BDM_RC_OK);
+   cmdStart(CMD_USBDM_CONNECT);       // Reset drops the connection
+   CHECK(cmdRun() == BDM_RC_OK);
+}
+
+//! Fill model memory with reproducible pseudo-random data
+//!
+static void fillRandom(U16 address, unsigned size, U32 seed) {
+   while (size-- > 0) {
+      seed = seed*1103515245UL+12345;
+      HOST_MEM(address++) = (U8)(seed>>16);
+   }
+}
+
+//! Build a READ_MEM command (byte access)
+//!
+static void cmdReadMem(U16 address, U8 count) {
+   cmdStart(CMD_USBDM_READ_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(count);
+   cmdU32(address);
+}
+
+//! Build a WRITE_MEM command (byte access)
+//!
+static void cmdWriteMem(U16 address, U8 count, const U8 *data) {
+   cmdStart(CMD_USBDM_WRITE_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(count);
+   cmdU32(address);
+   cmdData(data, count);
+}
+
+//! Read target memory through CMD_USBDM_READ_MEM
+//!
+//! @return TRUE if the data matches the model memory
+//!
+static int readMatches(U16 address, U8 count) {
+   cmdReadMem(address, count);
+   if (cmdRun() != BDM_RC_OK)
+      return FALSE;
+   return (hostUsbResponseSize == 1U+count) &&
+          (memcmp(hostUsbResponse+1, &HOST_MEM(address), count) == 0);
+}
+
+//=========================================================================
+// CRC
+//
+//=========================================================================
+
+//! zlib crc32() - bitwise so it is independent of the firmware's table
+//!
+static U32 refCrc32(const U8 *data, unsigned size) {
+U32 crc = 0xFFFFFFFFUL;
+int bit;
+
+   while (size-- > 0) {
+      crc ^= *data++;
+      for (bit=0; bit<8; bit++)
+         crc = (crc>>1)^((crc&1)?0xEDB88320UL:0);
+   }
+   return ~crc;
+}
+
+static void testCrc(void) {
+static const struct {
+   U16      offset;
+   unsigned size;
+} ranges[] = {
+   {0, 0}, {0, 1}, {3, 5}, {0, 0x400}, {1, 0xFF}, {0x11, 0x1001}, {0, 0x3000},
+};
+unsigned index;
+U32      crc;
+
+   CHECK(refCrc32((const U8 *)"123456789", 9) == 0xCBF43926UL); // zlib check value
+
+   startHcs08();
+   fillRandom(0x1000, 0x4000, 1);
+   for (index=0; index<sizeof(ranges)/sizeof(ranges[0]); index++) {
+      cmdStart(CMD_USBDM_CRC_MEM);
+      cmdU8(MS_Byte);
+      cmdU8(0);
+      cmdU32(0x1000+ranges[index].offset);
+      cmdU32(ranges[index].size);
+      CHECK(cmdRun() == BDM_RC_OK);
+      CHECK(hostUsbResponseSize == 5);
+      (void)memcpy(&crc, hostUsbResponse+1, sizeof(crc));
+      CHECK(crc == refCrc32(&HOST_MEM(0x1000+ranges[index].offset), ranges[index].size));
+   }
+}
+
+//=========================================================================
+// Run-length encoding
+//
+//=========================================================================
+
+//! Memory with runs (erased, zero, short) between random data
+//!
+static void fillSparse(U8 *data, unsigned size) {
+unsigned index;
+
+   for (index=0; index<size; index++) {
+      switch ((index/100)%4) {
+         case 0:  data[index] = 0xFF;                        break;
+         case 1:  data[index] = (U8)(index*7+(index>>5));    break;
+         case 2:  data[index] = (index%3 == 0)?0x55:0x00;    break;
+         default: data[index] = 0x00;                        break;
+      }
+   }
+}
+
+//! Memory of short & long runs of random length - most expensive to encode
+//!
+static void fillRuns(U8 *data, unsigned size, U32 seed) {
+unsigned index = 0;
+unsigned run;
+
+   while (index < size) {
+      seed = seed*1103515245UL+12345;
+      run  = ((seed>>16)%8 == 0)?(seed>>8)%300:1+(seed>>8)%(RLE_MIN_RUN+2);
+      for (; (run > 0) && (index < size); run--)
+         data[index++] = (U8)(seed>>24);
+   }
+}
+
+#define RLE_BASE      (0x2000)
+#define RLE_SIZE      (0x3000)
+#define RLE_MAX_DATA  (MAX_COMMAND_SIZE-10-64)  // Encoded data limit of CMD_USBDM_WRITE_MEM_RLE
+
+//! Read target memory through CMD_USBDM_READ_MEM_RLE & hostRleDecode()
+//!
+//! @return # of commands used, 0 => data doesn't match the model memory
+//!
+static unsigned rleReadMatches(U32 address, U32 size) {
+static U8 decoded[0x10000];
+unsigned  commands = 0;
+U32       offset;
+U32       count;
+U16       covered;
+long      decodedSize;
+
+   for (offset=0; offset<size; offset+=covered) {
+      count = size-offset;
+      if (count > 0xFFFF)
+         count = 0xFFFF;
+      cmdStart(CMD_USBDM_READ_MEM_RLE);
+      cmdU8(MS_Byte);
+      cmdU8(0);
+      cmdU32(address+offset);
+      cmdU16((U16)count);
+      if ((cmdRun() != BDM_RC_OK) || (hostUsbResponseSize < 3) || (hostUsbResponseSize > MAX_COMMAND_SIZE))
+         return 0;
+      (void)memcpy(&covered, hostUsbResponse+1, sizeof(covered));
+      if ((covered == 0) || (covered > count))
+         return 0;
+      decodedSize = hostRleDecode(hostUsbResponse+3, hostUsbResponseSize-3, decoded, sizeof(decoded));
+      if ((decodedSize != covered) || (memcmp(decoded, &HOST_MEM(address+offset), covered) != 0))
+         return 0;
+      commands++;
+   }
+   return commands;
+}
+
+//! Write target memory through hostRleEncode() & CMD_USBDM_WRITE_MEM_RLE
+//!
+//! @return # of commands used, 0 => a command failed
+//!
+static unsigned rleWrite(U32 address, const U8 *data, U32 size) {
+U8       encoded[RLE_MAX_DATA];
+unsigned encodedSize;
+unsigned commands = 0;
+unsigned consumed;
+U32      offset;
+U32      count;
+U32      written;
+
+   for (offset=0; offset<size; offset+=consumed) {
+      count = size-offset;
+      if (count > 0xFFFF)
+         count = 0xFFFF;
+      encodedSize = hostRleEncode(data+offset, count, encoded, sizeof(encoded), &consumed);
+      cmdStart(CMD_USBDM_WRITE_MEM_RLE);
+      cmdU8(MS_Byte);
+      cmdU8(0);
+      cmdU32(address+offset);
+      cmdU16((U16)consumed);
+      cmdData(encoded, encodedSize);
+      if (cmdRun() != BDM_RC_OK)
+         return 0;
+      (void)memcpy(&written, hostUsbResponse+1, sizeof(written));
+      if (written != consumed)
+         return 0;
+      commands++;
+   }
+   return commands;
+}
+
+static void testRle(void) {
+static U8 pattern[RLE_SIZE];
+U8        decoded[0x100];
+U32       seed;
+
+   startHcs08();
+
+   // Read - decoded responses must reproduce memory
+   fillSparse(&HOST_MEM(RLE_BASE), RLE_SIZE);
+   CHECK(rleReadMatches(RLE_BASE, RLE_SIZE) != 0);
+   for (seed=1; seed<=20; seed++) {
+      fillRuns(&HOST_MEM(RLE_BASE), RLE_SIZE, seed);
+      CHECK(rleReadMatches(RLE_BASE, RLE_SIZE) != 0);
+   }
+
+   // Runs continue across the 64 byte pieces - erased memory needs 2 bytes per RLE_MAX_RUN
+   (void)memset(&HOST_MEM(RLE_BASE), 0xFF, RLE_SIZE);
+   CHECK(rleReadMatches(RLE_BASE, RLE_SIZE) == 2);
+   CHECK(hostUsbResponseSize-3 <= 2*((RLE_SIZE+RLE_MAX_RUN-1)/RLE_MAX_RUN));
+
+   // Write - encoded data must be written exactly
+   fillSparse(pattern, sizeof(pattern));
+   fillRandom(RLE_BASE, RLE_SIZE, 2);
+   CHECK(rleWrite(RLE_BASE, pattern, RLE_SIZE) != 0);
+   CHECK(memcmp(pattern, &HOST_MEM(RLE_BASE), RLE_SIZE) == 0);
+
+   // Malformed (truncated literal) - nothing may be written
+   (void)memcpy(decoded, &HOST_MEM(RLE_BASE), 0x100);
+   cmdStart(CMD_USBDM_WRITE_MEM_RLE);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(RLE_BASE);
+   cmdU16(0x90);
+   cmdU8(0x80+0x7F);   // 130 x 0xAA
+   cmdU8(0xAA);
+   cmdU8(0x0F);        // 16 literal bytes but only 2 follow
+   cmdU8(0x01);
+   cmdU8(0x02);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   CHECK(memcmp(decoded, &HOST_MEM(RLE_BASE), 0x100) == 0);
+}
+
+//=========================================================================
+// Streamed read
+//
+//=========================================================================
+
+//! CMD_USBDM_READ_MEM_STREAM of size bytes
+static void buildStream(U32 size) {
+   cmdStart(CMD_USBDM_READ_MEM_STREAM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0);
+   cmdU16((U16)size);
+}
+
+static void testStream(void) {
+static const U16 sizes[] = {1, 63, 64, 65, 127, 128, 0x1000, 0xFFFF};
+unsigned index;
+unsigned size;
+uint64_t bits;
+
+   startHcs08();
+   fillRandom(0, 0x10000, 3);
+
+   // Complete - [0] = status, data, final status
+   for (index=0; index<sizeof(sizes)/sizeof(sizes[0]); index++) {
+      size = sizes[index];
+      buildStream(size);
+      CHECK(cmdRun() == BDM_RC_OK);
+      CHECK(hostUsbResponseSize == size+2);
+      CHECK(memcmp(hostUsbResponse+1, &HOST_MEM(0), size) == 0);
+      CHECK(hostUsbResponse[size+1] == BDM_RC_OK);
+      CHECK(hostUsb.failures == 0);
+   }
+
+   // Aborted - data read so far then the final status
+   buildStream(0x1000);
+   bits = hostWire.bits;
+   CHECK(cmdRun() == BDM_RC_OK);
+   bits = hostWire.bits-bits;
+   buildStream(0x1000);
+   hostAbortAtBits = hostWire.bits+bits/2;
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK((hostUsbResponseSize >= 2) && (hostUsbResponseSize < 0x1000+2));
+   CHECK(memcmp(hostUsbResponse+1, &HOST_MEM(0), hostUsbResponseSize-2) == 0);
+   CHECK(hostUsbResponse[hostUsbResponseSize-1] == BDM_RC_ABORTED);
+   CHECK(hostUsb.failures == 1);
+   CHECK(hostAbortAtBits == 0);
+
+   // Range must be whole elements - checked before the stream starts
+   cmdStart(CMD_USBDM_READ_MEM_STREAM);
+   cmdU8(MS_Long);
+   cmdU8(0);
+   cmdU32(0x1000);
+   cmdU16(0x102);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   CHECK(hostUsbResponseSize == 1);
+   cmdStart(CMD_USBDM_READ_MEM_STREAM);
+   cmdU8(MS_Word);
+   cmdU8(0);
+   cmdU32(0x1001);
+   cmdU16(0x100);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   CHECK(hostUsbResponseSize == 1);
+}
+
+//=========================================================================
+// RLE round trip of S-record images
+//
+//=========================================================================
+
+static char **testFiles;     //!< Files named after the test on the command line
+static int    numTestFiles;
+
+//! Value of pairs of hex digits
+//!
+//! @return value, -1 => not hex
+//!
+static long hexValue(const char *text, unsigned digits) {
+long value = 0;
+
+   while (digits-- > 0) {
+      if (!isxdigit((unsigned char)*text))
+         return -1;
+      value = (value<<4)+(isdigit((unsigned char)*text)?*text-'0':toupper((unsigned char)*text)-'A'+10);
+      text++;
+   }
+   return value;
+}
+
+//! Load the data records (S1, S2 & S3) of an S-record file
+//!
+//! Addresses are truncated to 16 bits like the model memory
+//!
+//! @param fileName - file to load
+//! @param image    - 64K image, loaded bytes are written
+//! @param start    - lowest address loaded
+//!
+//! @return # of bytes loaded, 0 => file can't be read or is malformed
+//!
+static unsigned loadSrec(const char *fileName, U8 *image, U32 *start) {
+FILE    *fp = fopen(fileName, "r");
+char     line[600];
+unsigned loaded = 0;
+unsigned addressSize;
+unsigned count;
+unsigned index;
+U32      address;
+U8       checksum;
+long     value;
+
+   if (fp == NULL) {
+      fprintf(stderr, "Can't open '%s'\n", fileName);
+      return 0;
+   }
+   while (fgets(line, sizeof(line), fp) != NULL) {
+      if ((line[0] != 'S') || (line[1] < '1') || (line[1] > '3'))
+         continue;   // Header, count & start records
+      addressSize = line[1]-'0'+1;
+      value       = hexValue(line+2, 2);
+      if ((value < (long)addressSize+1) || (strlen(line) < 4+2*(size_t)value)) {
+         loaded = 0;
+         break;
+      }
+      count    = (unsigned)value;
+      checksum = (U8)count;
+      address  = 0;
+      for (index=0; index<count; index++) {
+         value = hexValue(line+4+2*index, 2);
+         if (value < 0)
+            break;
+         checksum += (U8)value;
+         if (index < addressSize)
+            address = (address<<8)+(U32)value;
+         else if (index < count-1) {
+            if ((loaded == 0) || ((U16)(address+index-addressSize) < *start))
+               *start = (U16)(address+index-addressSize);
+            image[(U16)(address+index-addressSize)] = (U8)value;
+            loaded++;
+         }
+      }
+      if ((index < count) || (checksum != 0xFF)) {
+         loaded = 0;
+         break;
+      }
+   }
+   fclose(fp);
+   if (loaded == 0)
+      fprintf(stderr, "'%s' is not a valid S-record file\n", fileName);
+   return loaded;
+}
+
+//! Firmware images - READ_MEM_RLE of the complete (mostly erased) 64K memory
+//! and WRITE_MEM_RLE of the image (from its lowest address) must reproduce
+//! them through the host codec
+//!
+static void testSrec(void) {
+static U8 image[HOST_MEMORY_SIZE];
+int       file;
+unsigned  commands;
+U32       start;
+
+   CHECK(numTestFiles > 0);
+   for (file=0; file<numTestFiles; file++) {
+      (void)memset(image, 0xFF, sizeof(image));
+      CHECK(loadSrec(testFiles[file], image, &start) > 0);
+
+      // Read
+      startHcs08();
+      (void)memcpy(hostMemory, image, sizeof(image));
+      commands = rleReadMatches(0, HOST_MEMORY_SIZE);
+      CHECK(commands != 0);
+      // Must do better than READ_MEM
+      CHECK(commands < HOST_MEMORY_SIZE/(MAX_COMMAND_SIZE-1));
+
+      // Write - below start is left alone (registers, RAM)
+      (void)memset(hostMemory+start, 0x00, HOST_MEMORY_SIZE-start);
+      CHECK(rleWrite(start, image+start, HOST_MEMORY_SIZE-start) != 0);
+      CHECK(memcmp(hostMemory, image, sizeof(image)) == 0);
+   }
+}
+
+//=========================================================================
+// Batch
+//
+//=========================================================================
+
+#define BATCH_COMMANDS (8)
+
+//! Build command # n of the batch test
+//!
+static void cmdBatchEntry(unsigned n) {
+static const U8 data[] = {0x11, 0x22, 0x33, 0x44, 0x55};
+
+   switch (n) {
+      case 0: cmdWriteMem(0x0200, sizeof(data), data); break;
+      case 1: cmdReadMem(0x01FE, 9);                   break;
+      case 2:
+         cmdStart(CMD_USBDM_WRITE_REG);
+         cmdU16(0x0B00);   // PC
+         cmdU16(0);
+         cmdU16(0x1234);
+         break;
+      case 3:
+         cmdStart(CMD_USBDM_READ_REG);
+         cmdU16(0x0B00);   // PC
+         break;
+      case 4: cmdStart(CMD_USBDM_READ_STATUS_REG);     break;
+      case 5:
+         cmdStart(CMD_USBDM_MODIFY_MEM);
+         cmdU8(MS_Byte);
+         cmdU8(0);
+         cmdU32(0x0201);
+         cmdU32(0x0F);     // AND
+         cmdU32(0xA0);     // OR
+         break;
+      case 6: cmdReadMem(0x0200, 4);                   break;
+      case 7:
+         cmdStart(CMD_USBDM_POLL_MEM);
+         cmdU8(MS_Byte);
+         cmdU8(0);
+         cmdU32(0x0201);
+         cmdU32(0xFF);     // Mask
+         cmdU32(0xA2);     // Expected
+         cmdU16(10);       // Timeout
+         break;
+   }
+}
+
+static void testBatch(void) {
+U8       expected[BATCH_COMMANDS][MAX_COMMAND_SIZE];
+U8       expectedSize[BATCH_COMMANDS];
+U8       batch[MAX_COMMAND_SIZE];
+unsigned batchSize = 0;
+unsigned offset;
+unsigned n;
+
+   // Individually
+   startHcs08();
+   for (n=0; n<BATCH_COMMANDS; n++) {
+      cmdBatchEntry(n);
+      (void)memcpy(batch+batchSize, cmd, cmd[0]);
+      batchSize += cmd[0];
+      CHECK(cmdRun() == BDM_RC_OK);
+      expectedSize[n] = (U8)hostUsbResponseSize;
+      (void)memcpy(expected[n], hostUsbResponse, hostUsbResponseSize);
+      expected[n][0] &= 0x7F;
+   }
+
+   // As a batch from the same state
+   startHcs08();
+   cmdStart(CMD_USBDM_EXECUTE_BATCH);
+   cmdU8(BATCH_STOP_ON_ERROR);
+   cmdData(batch, batchSize);
+   CHECK(cmdRun() == BDM_RC_OK);
+   offset = 1;
+   for (n=0; n<BATCH_COMMANDS; n++) {
+      CHECK(offset < hostUsbResponseSize);
+      if (offset >= hostUsbResponseSize)
+         return;
+      CHECK(hostUsbResponse[offset] == expectedSize[n]);
+      CHECK(memcmp(hostUsbResponse+offset+1, expected[n], expectedSize[n]) == 0);
+      offset += 1+hostUsbResponse[offset];
+   }
+   CHECK(offset == hostUsbResponseSize);
+
+   // A bad entry anywhere rejects the whole batch before anything is done
+   startHcs08();
+   cmdBatchEntry(0);               // WRITE_MEM
+   batchSize = cmd[0];
+   (void)memcpy(batch, cmd, batchSize);
+   cmdStart(CMD_USBDM_EXECUTE_BATCH);
+   cmdU8(0);
+   cmdData(batch, batchSize);
+   cmdU8(12);                      // CRC_MEM - not allowed in a batch
+   cmdU8(CMD_USBDM_CRC_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x0200);
+   cmdU32(4);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   CHECK(HOST_MEM(0x0200) == 0xFF);
+}
+
+//=========================================================================
+// Read cache
+//
+//=========================================================================
+
+static U16 cacheHits(void) {
+U16 hits;
+
+   cmdStart(CMD_USBDM_SET_READ_CACHE);
+   cmdU8(READ_CACHE_ENABLE);
+   CHECK(cmdRun() == BDM_RC_OK);
+   (void)memcpy(&hits, hostUsbResponse+1, sizeof(hits));
+   return hits;
+}
+
+static void testCache(void) {
+static const U8 data[] = {1, 2, 3, 4};
+BDM_Option_t options;
+U8  value;
+U16 pc;
+
+   startHcs08();
+   cmdStart(CMD_USBDM_SET_READ_CACHE);
+   cmdU8(READ_CACHE_ENABLE|READ_CACHE_HALTED);
+   CHECK(cmdRun() == BDM_RC_OK);
+
+   // Repeated reads are hits
+   CHECK(readMatches(0x0300, 16));
+   CHECK(readMatches(0x0300, 16));
+   CHECK(cacheHits() == 1);
+
+   // Writes through the BDM
+   CHECK(readMatches(0x0300, 16));
+   cmdWriteMem(0x0304, sizeof(data), data);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(readMatches(0x0300, 16));
+
+   cmdStart(CMD_USBDM_FILL_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x0302);
+   cmdU32(3);
+   cmdU32(0x5A);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(readMatches(0x0300, 16));
+
+   cmdStart(CMD_USBDM_MODIFY_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x030F);
+   cmdU32(0x00);
+   cmdU32(0x77);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(readMatches(0x0300, 16));
+
+   cmdStart(CMD_USBDM_WRITE_MEM_RLE);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x0300);
+   cmdU16(8);
+   cmdU8(0x80+8-RLE_MIN_RUN);
+   cmdU8(0xC3);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(readMatches(0x0300, 16));
+
+   // Registers
+   cmdStart(CMD_USBDM_READ_REG);
+   cmdU16(0x0B00);   // PC
+   CHECK(cmdRun() == BDM_RC_OK);
+   cmdStart(CMD_USBDM_WRITE_REG);
+   cmdU16(0x0B00);
+   cmdU16(0);
+   cmdU16(0x4321);
+   CHECK(cmdRun() == BDM_RC_OK);
+   cmdStart(CMD_USBDM_READ_REG);
+   cmdU16(0x0B00);
+   CHECK(cmdRun() == BDM_RC_OK);
+   (void)memcpy(&pc, hostUsbResponse+hostUsbResponseSize-2, sizeof(pc));
+   CHECK(pc == 0x4321);
+
+   // Target runs & changes memory
+   CHECK(readMatches(0x0300, 16));
+   cmdStart(CMD_USBDM_TARGET_GO);
+   CHECK(cmdRun() == BDM_RC_OK);
+   value = HOST_MEM(0x0300);
+   HOST_MEM(0x0300) = value+1;
+   cmdStart(CMD_USBDM_TARGET_HALT);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(readMatches(0x0300, 16));
+
+   // Target reset & changes memory
+   cmdStart(CMD_USBDM_TARGET_RESET);
+   cmdU8(RESET_SPECIAL|RESET_SOFTWARE);
+   CHECK(cmdRun() == BDM_RC_OK);
+   cmdStart(CMD_USBDM_CONNECT);
+   CHECK(cmdRun() == BDM_RC_OK);
+   HOST_MEM(0x0301) ^= 0xFF;
+   CHECK(readMatches(0x0300, 16));
+
+   // Re-connect (speed re-measured) by a read that misses
+   options = bdm_option;
+   options.autoReconnect = AUTOCONNECT_ALWAYS;
+   cmdStart(CMD_USBDM_SET_OPTIONS);
+   cmdData(&options, sizeof(options));
+   CHECK(cmdRun() == BDM_RC_OK);
+   cmdStart(CMD_USBDM_SET_READ_CACHE);
+   cmdU8(READ_CACHE_ENABLE|READ_CACHE_HALTED);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(readMatches(0x0300, 16));
+   HOST_MEM(0x0302) ^= 0xFF;
+   halTimerAdvance((CONNECTION_VALIDms+1)*(uint32_t)TIMER_MICROSECOND(1000));
+   CHECK(readMatches(0x0310, 16));
+   CHECK(readMatches(0x0300, 16));
+}
+
+//=========================================================================
+// SYNC
+//
+//=========================================================================
+
+static void testSync(void) {
+static const U8 data[] = {1, 2, 3, 4};
+BDM_Option_t options;
+uint64_t     syncs;
+unsigned     n;
+
+   startHcs08();
+   options = bdm_option;
+   options.autoReconnect = AUTOCONNECT_ALWAYS;
+   cmdStart(CMD_USBDM_SET_OPTIONS);
+   cmdData(&options, sizeof(options));
+   CHECK(cmdRun() == BDM_RC_OK);
+
+   // At most one SYNC for a run of reads
+   syncs = hostWire.syncs;
+   for (n=0; n<10; n++)
+      CHECK(readMatches(0x0100, 8));
+   CHECK(hostWire.syncs-syncs <= 1);
+
+   // None for memory & register writes or rejected commands
+   syncs = hostWire.syncs;
+   for (n=0; n<5; n++) {
+      cmdWriteMem(0x0100, sizeof(data), data);
+      CHECK(cmdRun() == BDM_RC_OK);
+   }
+   cmdStart(CMD_USBDM_WRITE_REG);
+   cmdU16(0x0B00);
+   cmdU16(0);
+   cmdU16(0x1000);
+   CHECK(cmdRun() == BDM_RC_OK);
+   cmdStart(CMD_USBDM_VERIFY_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(8);
+   cmdU32(0x0100);
+   cmdU8(0);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   CHECK(readMatches(0x0100, 8));
+   CHECK(hostWire.syncs == syncs);
+
+   // One after the target runs
+   cmdStart(CMD_USBDM_TARGET_GO);
+   CHECK(cmdRun() == BDM_RC_OK);
+   syncs = hostWire.syncs;
+   cmdStart(CMD_USBDM_TARGET_HALT);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(readMatches(0x0100, 8));
+   CHECK(hostWire.syncs-syncs == 1);
+
+   // One once the measured speed is old
+   syncs = hostWire.syncs;
+   halTimerAdvance((CONNECTION_VALIDms+1)*(uint32_t)TIMER_MICROSECOND(1000));
+   CHECK(readMatches(0x0100, 8));
+   CHECK(readMatches(0x0100, 8));
+   CHECK(hostWire.syncs-syncs == 1);
+}
+
+//=========================================================================
+// HC12 speed guessing
+//
+//=========================================================================
+
+//! TRUE if a speed (sync_length) is within 3% of a bus frequency
+//!
+static int isSpeed(U16 syncLength, U32 frequency) {
+long expected = SYNC_MULTIPLE(frequency);
+long error    = (long)syncLength-expected;
+
+   return labs(error) <= expected/32;
+}
+
+//! Connect to the modelled HC12
+//!
+//! @return # of distinct speeds tried
+//!
+static unsigned connectHc12(U32 frequency, U16 partid) {
+   hostHc12Target(frequency, partid);
+   CHECK(bdm_physicalConnect() == BDM_RC_OK);
+   CHECK(cable_status.speed == SPEED_GUESSED);
+   CHECK(isSpeed(cable_status.sync_length, frequency));
+   return hostHc12NumTried;
+}
+
+static void testSpeed(void) {
+unsigned tried;
+
+   hostModelReset();
+   CHECK(bdm_setTarget(T_HC12) == BDM_RC_OK);
+   bdm_option.guessSpeed = TRUE;
+
+   // Unknown part - initial learned speeds (8, 16 MHz) then 'nice' speeds (4, 8, 16, 32, 24 MHz)
+   tried = connectHc12(24000000UL, 0x1234);
+   CHECK(tried == 7);
+   CHECK(isSpeed(hostHc12SpeedsTried[0],  8000000UL));
+   CHECK(isSpeed(hostHc12SpeedsTried[1], 16000000UL));
+   CHECK(isSpeed(hostHc12SpeedsTried[2],  4000000UL));
+   CHECK(isSpeed(hostHc12SpeedsTried[6], 24000000UL));
+
+   // Same part & speed - found first time
+   CHECK(connectHc12(24000000UL, 0x1234) == 1);
+
+   // Another part - previous speed then the next learned speed
+   tried = connectHc12(8000000UL, 0x5678);
+   CHECK(tried == 2);
+   CHECK(isSpeed(hostHc12SpeedsTried[0], 24000000UL));
+
+   // Back to the first part - most recently used first
+   tried = connectHc12(24000000UL, 0x1234);
+   CHECK(tried == 2);
+   CHECK(isSpeed(hostHc12SpeedsTried[0],  8000000UL));
+   CHECK(isSpeed(hostHc12SpeedsTried[1], 24000000UL));
+}
+
+//=========================================================================
+// VERIFY, POLL & GATHER
+//
+//=========================================================================
+
+static void testVerify(void) {
+U8  data[32];
+U16 mismatch;
+
+   startHcs08();
+   fillRandom(0x0400, sizeof(data), 3);
+   (void)memcpy(data, &HOST_MEM(0x0400), sizeof(data));
+
+   // All match
+   cmdStart(CMD_USBDM_VERIFY_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(sizeof(data));
+   cmdU32(0x0400);
+   cmdU8(VERIFY_FIRST_MISMATCH);
+   cmdData(data, sizeof(data));
+   CHECK(cmdRun() == BDM_RC_OK);
+   (void)memcpy(&mismatch, hostUsbResponse+1, sizeof(mismatch));
+   CHECK(mismatch == 0xFFFF);
+
+   // First mismatch & bitmap
+   data[5]  ^= 0x01;
+   data[31] ^= 0x80;
+   cmdStart(CMD_USBDM_VERIFY_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(sizeof(data));
+   cmdU32(0x0400);
+   cmdU8(VERIFY_FIRST_MISMATCH);
+   cmdData(data, sizeof(data));
+   CHECK(cmdRun() == BDM_RC_OK);
+   (void)memcpy(&mismatch, hostUsbResponse+1, sizeof(mismatch));
+   CHECK(mismatch == 5);
+
+   cmdStart(CMD_USBDM_VERIFY_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(sizeof(data));
+   cmdU32(0x0400);
+   cmdU8(VERIFY_BITMAP);
+   cmdData(data, sizeof(data));
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(hostUsbResponseSize == 1+sizeof(data)/8);
+   CHECK((hostUsbResponse[1] == 0x20) && (hostUsbResponse[2] == 0) &&
+         (hostUsbResponse[3] == 0)    && (hostUsbResponse[4] == 0x80));
+
+   // Expected data missing
+   cmdStart(CMD_USBDM_VERIFY_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(sizeof(data));
+   cmdU32(0x0400);
+   cmdU8(VERIFY_FIRST_MISMATCH);
+   cmdData(data, sizeof(data)-1);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+}
+
+static void testPoll(void) {
+uint64_t startTicks;
+U16      iterations;
+
+   startHcs08();
+   HOST_MEM(0x0080) = 0xA5;
+
+   // Met immediately
+   cmdStart(CMD_USBDM_POLL_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x0080);
+   cmdU32(0xF0);
+   cmdU32(0xA0);
+   cmdU16(100);
+   CHECK(cmdRun() == BDM_RC_OK);
+   (void)memcpy(&iterations, hostUsbResponse+2, sizeof(iterations));
+   CHECK((hostUsbResponse[1] == TRUE) && (iterations == 1) && (hostUsbResponse[4] == 0xA5));
+
+   // Never met - times out after the given time
+   startTicks = halTimerElapsed();
+   cmdStart(CMD_USBDM_POLL_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x0080);
+   cmdU32(0xFF);
+   cmdU32(0x00);
+   cmdU16(5);
+   CHECK(cmdRun() == BDM_RC_OK);
+   (void)memcpy(&iterations, hostUsbResponse+2, sizeof(iterations));
+   CHECK((hostUsbResponse[1] == FALSE) && (iterations > 1));
+   // Timeout is also counted in whole USB frames so may be up to 1 ms short
+   CHECK(halTimerElapsed()-startTicks >= 4*(uint64_t)TIMER_MICROSECOND(1000));
+   CHECK(halTimerElapsed()-startTicks <  7*(uint64_t)TIMER_MICROSECOND(1000));
+
+   // Timeout missing
+   cmdStart(CMD_USBDM_POLL_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x0080);
+   cmdU32(0xFF);
+   cmdU32(0x00);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   // Illegal element size
+   cmdStart(CMD_USBDM_POLL_MEM);
+   cmdU8(3);
+   cmdU8(0);
+   cmdU32(0x0080);
+   cmdU32(0xFF);
+   cmdU32(0x00);
+   cmdU16(5);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+}
+
+//! Add a CMD_USBDM_READ_MEM_GATHER region
+//!
+static void cmdRegion(U8 count, U16 address) {
+   cmdU8(MS_Byte);
+   cmdU8(count);
+   cmdU32(address);
+}
+
+static void testGather(void) {
+uint64_t transfers;
+unsigned n;
+
+   startHcs08();
+   fillRandom(0x0500, 0x300, 4);
+
+   cmdStart(CMD_USBDM_READ_MEM_GATHER);
+   cmdU8(3);
+   cmdRegion(8,  0x0500);
+   cmdRegion(1,  0x0610);
+   cmdRegion(40, 0x07C0);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(hostUsbResponseSize == 1+8+1+40);
+   CHECK(memcmp(hostUsbResponse+1,  &HOST_MEM(0x0500), 8)  == 0);
+   CHECK(memcmp(hostUsbResponse+9,  &HOST_MEM(0x0610), 1)  == 0);
+   CHECK(memcmp(hostUsbResponse+10, &HOST_MEM(0x07C0), 40) == 0);
+
+   // Bad commands are rejected without any target access
+   transfers = hostWire.transfers;
+
+   cmdStart(CMD_USBDM_READ_MEM_GATHER);   // Descriptors missing
+   cmdU8(3);
+   cmdRegion(8, 0x0500);
+   cmdRegion(8, 0x0600);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   cmdStart(CMD_USBDM_READ_MEM_GATHER);   // Zero length region
+   cmdU8(2);
+   cmdRegion(8, 0x0500);
+   cmdRegion(0, 0x0600);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   cmdStart(CMD_USBDM_READ_MEM_GATHER);   // Results don't fit
+   cmdU8(8);
+   for (n=0; n<8; n++)
+      cmdRegion(40, (U16)(0x0500+n*40));
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   cmdStart(CMD_USBDM_READ_MEM_GATHER);   // No regions
+   cmdU8(0);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   CHECK(hostWire.transfers == transfers);
+}
+
+//=========================================================================
+// Target events
+//
+//=========================================================================
+
+//! Wait for the next halt check by commandIdle()
+//!
+//! @return TRUE if target event status shows the target halted
+//!
+static int idleShowsHalt(void) {
+   halTimerAdvance(10*(uint32_t)TIMER_MICROSECOND(1000));
+   commandIdle();
+   return (peekStatusWord()&S_HALT) != 0;
+}
+
+static void testEvents(void) {
+uint64_t transfers;
+
+   startHcs08();
+   CHECK(idleShowsHalt());    // Reset into active background mode
+
+   cmdStart(CMD_USBDM_TARGET_GO);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(!idleShowsHalt());
+
+   hostHcs08Halt();           // Breakpoint
+   CHECK(idleShowsHalt());
+
+   // Checked no more than every 10 ms
+   transfers = hostWire.transfers;
+   commandIdle();
+   commandIdle();
+   CHECK(hostWire.transfers == transfers);
+
+   // Unknown without a connection
+   cmdStart(CMD_USBDM_TARGET_RESET);
+   cmdU8(RESET_SPECIAL|RESET_SOFTWARE);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(!idleShowsHalt());
+}
+
+//=========================================================================
+// BDM Tx bit timing
+//
+// The HCS08 Tx routines in BDM.c can't run on the host so their asm is
+// read from BDM.c and stepped instruction by instruction with the HCS08
+// cycle counts.  The BKGD edges are then checked against the BDC bit
+// window at both ends of the target frequency range of each
+// txConfiguration[] entry.
+//
+//=========================================================================
+
+#define TX_MAX_INSTRUCTIONS (40)
+#define TX_MAX_EDGES        (2*8*8+2)
+#define TX_MAX_ENTRIES      (30)
+
+#define BDC_ONE_LOW_MAX   (8.5)  //!< Longest low for a '1' (BDC cycles) - target samples after 10
+#define BDC_ZERO_LOW_MIN  (11.0) //!< Shortest low for a '0' (BDC cycles)
+#define BDC_BIT_MIN       (16.0) //!< Shortest bit time (BDC cycles)
+#define BDC_TIMEOUT       (512.0)//!< BDC abandons a command after this long between bits (see SOFT_RESETus)
+
+typedef struct {
+   char label[16];     //!< Label of this instruction (if any)
+   char mnemonic[24];
+   char operand[40];
+   int  annotated;     //!< Cycle count from comment [n ...] (0 => none)
+} TxInstruction;
+
+typedef struct {
+   unsigned       count;
+   TxInstruction  instructions[TX_MAX_INSTRUCTIONS];
+} TxRoutine;
+
+typedef struct {
+   unsigned syncThreshold;
+   char     txFunc[24];
+   char     txBlockFunc[24];
+   unsigned time[3];
+} TxEntry;
+
+//! BKGD low pulses (bus cycles)
+typedef struct {
+   unsigned count;
+   unsigned fall[TX_MAX_EDGES];
+   unsigned rise[TX_MAX_EDGES];
+} TxPulses;
+
+static char *bdmSource;
+
+//! Read BDM.c
+//!
+static int readBdmSource(void) {
+FILE *fp;
+long  size;
+
+   if (bdmSource != NULL)
+      return TRUE;
+   fp = fopen(BDM_SOURCE, "rb");
+   if (fp == NULL) {
+      fprintf(stderr, "Can't open %s\n", BDM_SOURCE);
+      return FALSE;
+   }
+   (void)fseek(fp, 0, SEEK_END);
+   size = ftell(fp);
+   (void)fseek(fp, 0, SEEK_SET);
+   bdmSource = malloc(size+1);
+   if ((bdmSource == NULL) || (fread(bdmSource, 1, size, fp) != (size_t)size)) {
+      (void)fclose(fp);
+      return FALSE;
+   }
+   bdmSource[size] = '\0';
+   (void)fclose(fp);
+   return TRUE;
+}
+
+//! Get the asm block of the (first) definition of a Tx routine
+//!
+static int parseTxRoutine(const char *name, TxRoutine *routine) {
+char        header[64];
+const char *line;
+const char *end;
+char        text[160];
+char        label[16] = "";
+size_t      length;
+char       *comment;
+char       *bracket;
+TxInstruction *ins;
+
+   routine->count = 0;
+   (void)snprintf(header, sizeof(header), "\nvoid %s(", name);
+   line = strstr(bdmSource, header);
+   if (line == NULL)
+      return FALSE;
+   line = strstr(line, "asm {");
+   if (line == NULL)
+      return FALSE;
+   line = strchr(line, '\n')+1;
+   for (;;) {
+      end = strchr(line, '\n');
+      if ((end == NULL) || (end-line >= (long)sizeof(text)))
+         return FALSE;
+      length = (size_t)(end-line);
+      if ((length > 0) && (line[length-1] == '\r'))
+         length--;
+      (void)memcpy(text, line, length);
+      text[length] = '\0';
+      line = end+1;
+      comment = strstr(text, "//");
+      bracket = (comment == NULL)?NULL:strchr(comment, '[');
+      if (comment != NULL)
+         *comment = '\0';
+      if (strchr(text, '}') != NULL)
+         return routine->count > 0;
+      if (strchr(text, ':') != NULL) {
+         (void)sscanf(text, " %15[A-Za-z0-9_]", label);
+         continue;
+      }
+      if (routine->count >= TX_MAX_INSTRUCTIONS)
+         return FALSE;
+      ins = &routine->instructions[routine->count];
+      ins->operand[0] = '\0';
+      if (sscanf(text, " %23s %39s", ins->mnemonic, ins->operand) < 1)
+         continue;
+      ins->annotated = 0;
+      if ((bracket != NULL) && (sscanf(bracket+1, "%d", &ins->annotated) == 1) &&
+          (!isspace((unsigned char)bracket[1+strspn(bracket+1, "0123456789")])))
+         ins->annotated = 0;  // e.g. [4n] or [2+]
+      (void)strcpy(ins->label, label);
+      label[0] = '\0';
+      routine->count++;
+   }
+}
+
+//! Get txConfiguration[] entries
+//!
+static unsigned parseTxConfiguration(TxEntry *entries) {
+const char *line = strstr(bdmSource, "const TxConfiguration txConfiguration[]");
+unsigned    count = 0;
+
+   if (line == NULL)
+      return 0;
+   line = strstr(line, "\n{")+1;
+   while ((line = strstr(line, "\n{")) != NULL) {
+      line += 1;
+      if ((count >= TX_MAX_ENTRIES) ||
+          (sscanf(line, "{ %u, %23[^,], %23[^,], %u, %u ,%u", &entries[count].syncThreshold,
+                  entries[count].txFunc, entries[count].txBlockFunc,
+                  &entries[count].time[0], &entries[count].time[1], &entries[count].time[2]) != 6)) {
+         if (sscanf(line, "{ %u, %23[^,], %23[^,], %u, %u, %u", &entries[count].syncThreshold,
+                    entries[count].txFunc, entries[count].txBlockFunc,
+                    &entries[count].time[0], &entries[count].time[1], &entries[count].time[2]) != 6)
+            break;
+      }
+      count++;
+   }
+   return count;
+}
+
+//! HCS08 cycles for an instruction used by the Tx routines
+//!
+//! @param writeCycle - cycle (from 0) in which DATA_PORT is written
+//!
+//! @return cycles, 0 => unknown instruction
+//!
+static unsigned txCycles(const TxInstruction *ins, unsigned *writeCycle) {
+static const struct {
+   const char *mnemonic;
+   unsigned    cycles;
+   unsigned    writeCycle;
+} cycles[] = {
+   {"LDHX",  4, 0}, {"STHX", 4, 0}, {"AIX",  2, 0}, {"SEC",  1, 0}, {"CLC", 1, 0},
+   {"BRA",   3, 0}, {"BCS",  3, 0}, {"BNE",  3, 0}, {"BRN",  3, 0}, {"NOP", 1, 0},
+   {"ROLA",  1, 0}, {"PSHA", 2, 0}, {"PULA", 3, 0}, {"DBNZ", 7, 0}, {"DBNZA", 4, 0},
+   {"MOV",   4, 1}, {"STX",  3, 0},
+};
+unsigned index;
+
+   *writeCycle = 0;
+   if (strcmp(ins->mnemonic, "LDA") == 0)
+      return 3;  // IX & DIR
+   if (strcmp(ins->mnemonic, "LDX") == 0)
+      return (ins->operand[0] == '#')?2:3;
+   for (index=0; index<sizeof(cycles)/sizeof(cycles[0]); index++) {
+      if (strcmp(ins->mnemonic, cycles[index].mnemonic) == 0) {
+         *writeCycle = cycles[index].writeCycle;
+         return cycles[index].cycles;
+      }
+   }
+   return 0;
+}
+
+//! Find instruction with label
+//!
+static int txFindLabel(const TxRoutine *routine, const char *label) {
+unsigned index;
+
+   for (index=0; index<routine->count; index++) {
+      if (strcmp(routine->instructions[index].label, label) == 0)
+         return (int)index;
+   }
+   return -1;
+}
+
+//! BKGD level written by an operand (#BKGD_HIGH_MASK => high, other masks => low)
+//!
+static int txLevel(const char *mask) {
+   return strncmp(mask, "#BKGD_HIGH_MASK", 15) == 0;
+}
+
+//! Step a Tx routine
+//!
+//! @param data   - bytes to send (1 for the single byte routines)
+//! @param timing - txTiming1..3
+//!
+//! @return TRUE if the routine ran to BDM_3STATE_ASM
+//!
+static int txSimulate(const TxRoutine *routine, const U8 *data, unsigned count,
+                      const unsigned timing[3], TxPulses *pulses) {
+unsigned time    = 0;
+unsigned pc      = 0;
+unsigned a       = data[0];
+unsigned x       = 0;
+unsigned pointer = 0;
+unsigned stack   = 0;
+unsigned blockCount = count;
+int      carry   = 0;
+int      zero    = 0;
+int      level   = 1;
+int      target;
+unsigned cycles;
+unsigned writeCycle;
+int      branch;
+char     operand[40];
+const TxInstruction *ins;
+
+   pulses->count = 0;
+   while (time < 1000000UL) {
+      if (pc >= routine->count)
+         return FALSE;
+      ins = &routine->instructions[pc++];
+      if (strcmp(ins->mnemonic, "BDM_3STATE_ASM") == 0) {
+         return level && (pulses->count == 8*count);
+      }
+      cycles = txCycles(ins, &writeCycle);
+      if (cycles == 0) {
+         fprintf(stderr, "Unknown instruction %s %s\n", ins->mnemonic, ins->operand);
+         return FALSE;
+      }
+      if ((ins->annotated != 0) && (ins->annotated != (int)cycles)) {
+         fprintf(stderr, "%s %s - annotated %d cycles, should be %u\n", ins->mnemonic, ins->operand, ins->annotated, cycles);
+         return FALSE;
+      }
+      (void)strcpy(operand, ins->operand);
+      branch = FALSE;
+      if (strcmp(ins->mnemonic, "LDHX") == 0)       x = pointer;
+      else if (strcmp(ins->mnemonic, "STHX") == 0)  pointer = x;
+      else if (strcmp(ins->mnemonic, "AIX") == 0)   x += (unsigned)atoi(operand+1);
+      else if (strcmp(ins->mnemonic, "SEC") == 0)   carry = 1;
+      else if (strcmp(ins->mnemonic, "CLC") == 0)   carry = 0;
+      else if (strcmp(ins->mnemonic, "PSHA") == 0)  stack = a;
+      else if (strcmp(ins->mnemonic, "PULA") == 0)  a = stack;
+      else if (strcmp(ins->mnemonic, "NOP") == 0)   {}
+      else if (strcmp(ins->mnemonic, "BRN") == 0)   {}
+      else if (strcmp(ins->mnemonic, "BRA") == 0)   branch = TRUE;
+      else if (strcmp(ins->mnemonic, "BCS") == 0)   branch = carry;
+      else if (strcmp(ins->mnemonic, "BNE") == 0)   branch = !zero;
+      else if (strcmp(ins->mnemonic, "ROLA") == 0) {
+         a     = (a<<1)|carry;
+         carry = (a>>8)&1;
+         a    &= 0xFF;
+         zero  = (a == 0);
+      }
+      else if (strcmp(ins->mnemonic, "LDA") == 0) {
+         if (strcmp(operand, ",X") == 0)
+            a = (x < count)?data[x]:0;
+         else if (strncmp(operand, "txTiming", 8) == 0)
+            a = timing[operand[8]-'1'];
+         else
+            return FALSE;
+      }
+      else if (strcmp(ins->mnemonic, "LDX") == 0) {
+         if (operand[0] != '#')
+            return FALSE;
+         x = (unsigned)txLevel(operand);
+      }
+      else if (strcmp(ins->mnemonic, "DBNZA") == 0) {
+         // *+0 - loop on itself
+         a = (a-1)&0xFF;
+         if (a != 0) {
+            pc--;
+         }
+      }
+      else if (strcmp(ins->mnemonic, "DBNZ") == 0) {
+         if (strncmp(operand, "txBlockCount,", 13) != 0)
+            return FALSE;
+         blockCount = (blockCount-1)&0xFF;
+         if (blockCount != 0) {
+            (void)strcpy(operand, operand+13);
+            branch = TRUE;
+         }
+      }
+      else if ((strcmp(ins->mnemonic, "MOV") == 0) || (strcmp(ins->mnemonic, "STX") == 0)) {
+         int newLevel;
+         if (strcmp(ins->mnemonic, "MOV") == 0) {
+            if (strstr(operand, ",DATA_PORT") == NULL)
+               return FALSE;
+            newLevel = txLevel(operand);
+         }
+         else {
+            if (strcmp(operand, "DATA_PORT") != 0)
+               return FALSE;
+            newLevel = (int)x;
+         }
+         if (level && !newLevel) {
+            if (pulses->count >= TX_MAX_EDGES)
+               return FALSE;
+            pulses->fall[pulses->count] = time+writeCycle;
+         }
+         else if (!level && newLevel) {
+            pulses->rise[pulses->count++] = time+writeCycle;
+         }
+         level = newLevel;
+      }
+      else {
+         fprintf(stderr, "Unknown instruction %s %s\n", ins->mnemonic, operand);
+         return FALSE;
+      }
+      time += cycles;
+      if (branch && (strcmp(operand, "*+0") != 0)) {
+         target = txFindLabel(routine, operand);
+         if (target < 0)
+            return FALSE;
+         pc = (unsigned)target;
+      }
+   }
+   return FALSE;
+}
+
+//! Check the pulses of a Tx routine against the BDC bit window
+//!
+//! @param fMin, fMax - target BDC clock range (Hz)
+//!
+static int txCheckPulses(const char *name, const TxPulses *pulses, const U8 *data,
+                         double fMin, double fMax, unsigned lowTime[2]) {
+unsigned bit;
+unsigned low;
+unsigned period;
+int      value;
+int      ok = TRUE;
+
+   for (bit=0; bit<pulses->count; bit++) {
+      value = (data[bit/8]>>(7-bit%8))&1;
+      low   = pulses->rise[bit]-pulses->fall[bit];
+      if (lowTime[value] == 0)
+         lowTime[value] = low;
+      if (low != lowTime[value]) {
+         fprintf(stderr, "%s: bit %u '%d' low for %u cycles, expected %u\n", name, bit, value, low, lowTime[value]);
+         ok = FALSE;
+      }
+      if (value && (low*fMax/BUS_FREQ > BDC_ONE_LOW_MAX)) {
+         fprintf(stderr, "%s: '1' low for %.1f BDC cycles @%.2f MHz\n", name, low*fMax/BUS_FREQ, fMax/1e6);
+         ok = FALSE;
+      }
+      if (!value && (low*fMin/BUS_FREQ < BDC_ZERO_LOW_MIN)) {
+         fprintf(stderr, "%s: '0' low for %.1f BDC cycles @%.2f MHz\n", name, low*fMin/BUS_FREQ, fMin/1e6);
+         ok = FALSE;
+      }
+      if (bit+1 >= pulses->count)
+         break;  // Next bit is sent by a later call
+      period = pulses->fall[bit+1]-pulses->fall[bit];
+      if (period*fMin/BUS_FREQ < BDC_BIT_MIN) {
+         fprintf(stderr, "%s: bit %u is %.1f BDC cycles @%.2f MHz\n", name, bit, period*fMin/BUS_FREQ, fMin/1e6);
+         ok = FALSE;
+      }
+      if (period*fMax/BUS_FREQ >= BDC_TIMEOUT) {
+         fprintf(stderr, "%s: bit %u is %.1f BDC cycles @%.2f MHz\n", name, bit, period*fMax/BUS_FREQ, fMax/1e6);
+         ok = FALSE;
+      }
+   }
+   return ok;
+}
+
+static void testTxTiming(void) {
+static const U8 block[] = {0x00, 0xFF, 0xA5, 0x5A, 0x80, 0x01, 0x7F, 0xFE};
+TxEntry   entries[TX_MAX_ENTRIES];
+TxRoutine single;
+TxRoutine blocked;
+TxPulses  pulses;
+unsigned  numEntries;
+unsigned  entry;
+unsigned  index;
+unsigned  lowTime[2];
+double    fMin;
+double    fMax;
+
+   CHECK(readBdmSource());
+   if (bdmSource == NULL)
+      return;
+   numEntries = parseTxConfiguration(entries);
+   CHECK(numEntries > 2);
+
+   // First & last entries are out of range
+   for (entry=1; entry+1<numEntries; entry++) {
+      // sync_length is the time for 128 BDC cycles in 60MHz ticks
+      fMax = 128*60e6/entries[entry].syncThreshold;
+      fMin = 128*60e6/entries[entry+1].syncThreshold;
+      CHECK(parseTxRoutine(entries[entry].txFunc, &single));
+      CHECK(parseTxRoutine(entries[entry].txBlockFunc, &blocked));
+
+      // Single byte routine sets the bit times
+      (void)memset(lowTime, 0, sizeof(lowTime));
+      for (index=0; index<sizeof(block); index++) {
+         CHECK(txSimulate(&single, block+index, 1, entries[entry].time, &pulses));
+         CHECK(txCheckPulses(entries[entry].txFunc, &pulses, block+index, fMin, fMax, lowTime));
+      }
+      // Block routine must keep them, including the gap while fetching the next byte
+      for (index=1; index<=sizeof(block); index++) {
+         CHECK(txSimulate(&blocked, block, index, entries[entry].time, &pulses));
+         CHECK(txCheckPulses(entries[entry].txBlockFunc, &pulses, block, fMin, fMax, lowTime));
+      }
+   }
+}
+
+//=========================================================================
+// Multi-chunk memory commands
+//
+//=========================================================================
+
+//! Run a multi-chunk memory command to completion and with an abort
+//! arriving at each point during its 1st chunk
+//!
+//! @param build  - builds the command in cmd for a range of size bytes
+//! @param chunk  - # of bytes per chunk
+//! @param chunks - # of chunks for the complete run (>= 2)
+//!
+static void checkChunked(void (*build)(U32 size), unsigned chunk, unsigned chunks) {
+uint64_t chunkBits;
+uint64_t offset;
+
+   // One chunk - wire bits used by the 1st chunk of a longer range
+   build(chunk);
+   chunkBits = hostWire.bits;
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(commandProgress.done == chunk);
+   chunkBits = hostWire.bits-chunkBits;
+
+   // Complete - progress covers the whole range
+   build(chunk*chunks);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(commandProgress.done == chunk*chunks);
+
+   // Abort request arrives during the 1st chunk - the command stops by the end of it
+   for (offset=1; offset<chunkBits; offset++) {
+      build(chunk*chunks);
+      hostAbortAtBits = hostWire.bits+offset;
+      CHECK(cmdRun() == BDM_RC_ABORTED);
+      CHECK(hostUsbResponseSize == 1);
+      CHECK(commandProgress.done <= chunk);
+   }
+   hostAbortAtBits = 0;
+}
+
+//! CMD_USBDM_CRC_MEM of size bytes
+static void buildCrc(U32 size) {
+   cmdStart(CMD_USBDM_CRC_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x1000);
+   cmdU32(size);
+}
+
+//! CMD_USBDM_FILL_MEM of size bytes
+static void buildFill(U32 size) {
+   cmdStart(CMD_USBDM_FILL_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x1000);
+   cmdU32(size);
+   cmdU32(0x5A);
+}
+
+//! CMD_USBDM_HASH_MEM of size bytes in 64 byte blocks
+static void buildHash(U32 size) {
+   cmdStart(CMD_USBDM_HASH_MEM);
+   cmdU8(MS_Byte);
+   cmdU8(0x40);
+   cmdU32(0x1000);
+   cmdU16((U16)(size/0x40));
+}
+
+//! CMD_USBDM_READ_MEM_RLE of size bytes (of uniform memory)
+static void buildReadRle(U32 size) {
+   cmdStart(CMD_USBDM_READ_MEM_RLE);
+   cmdU8(MS_Byte);
+   cmdU8(0);
+   cmdU32(0x8000);
+   cmdU16((U16)size);
+}
+
+static void testChunks(void) {
+   startHcs08();
+   fillRandom(0x1000, 0x2000, 7);
+
+   // CRC
+   checkChunked(buildCrc, (MAX_COMMAND_SIZE-1)&~3, 4);
+   // Progress of a range > 64 KiB isn't truncated (HCS08 addresses wrap)
+   buildCrc(0x18000);
+   CHECK(cmdRun() == BDM_RC_OK);
+   CHECK(commandProgress.done == 0x18000);
+   cmdStart(CMD_USBDM_CRC_MEM);
+   cmdU8(MS_Word);
+   cmdU8(0);
+   cmdU32(0x1001);
+   cmdU32(0x100);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   cmdStart(CMD_USBDM_CRC_MEM);
+   cmdU8(MS_Long);
+   cmdU8(0);
+   cmdU32(0x1000);
+   cmdU32(0x102);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   cmdStart(CMD_USBDM_CRC_MEM);
+   cmdU8(3);
+   cmdU8(0);
+   cmdU32(0x1000);
+   cmdU32(0x3);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   // FILL
+   checkChunked(buildFill, (MAX_COMMAND_SIZE-8)&~3, 4);
+   CHECK(HOST_MEM(0x1000+4*((MAX_COMMAND_SIZE-8)&~3)-1) == 0x5A);
+   cmdStart(CMD_USBDM_FILL_MEM);
+   cmdU8(MS_Word);
+   cmdU8(0);
+   cmdU32(0x1001);
+   cmdU32(0x100);
+   cmdU32(0x5A5A);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   cmdStart(CMD_USBDM_FILL_MEM);
+   cmdU8(MS_Long);
+   cmdU8(0);
+   cmdU32(0x1000);
+   cmdU32(0x102);
+   cmdU32(0x5A5A5A5A);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   // HASH
+   checkChunked(buildHash, 0x40, 4);
+   cmdStart(CMD_USBDM_HASH_MEM);
+   cmdU8(MS_Word);
+   cmdU8(0x40);
+   cmdU32(0x1001);
+   cmdU16(4);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   cmdStart(CMD_USBDM_HASH_MEM);
+   cmdU8(MS_Long);
+   cmdU8(0x42);
+   cmdU32(0x1000);
+   cmdU16(4);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+
+   // READ_RLE
+   checkChunked(buildReadRle, 64, 4);
+   cmdStart(CMD_USBDM_READ_MEM_RLE);
+   cmdU8(MS_Word);
+   cmdU8(0);
+   cmdU32(0x8001);
+   cmdU16(0x100);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+   cmdStart(CMD_USBDM_READ_MEM_RLE);
+   cmdU8(MS_Long);
+   cmdU8(0);
+   cmdU32(0x8000);
+   cmdU16(0x102);
+   CHECK(cmdRun() == BDM_RC_ILLEGAL_PARAMS);
+}
+
+//=========================================================================
+
+static const struct {
+   const char *name;
+   void      (*test)(void);
+} tests[] = {
+   {"crc",    testCrc},
+   {"rle",    testRle},
+   {"batch",  testBatch},
+   {"cache",  testCache},
+   {"sync",   testSync},
+   {"speed",  testSpeed},
+   {"verify", testVerify},
+   {"poll",   testPoll},
+   {"gather", testGather},
+   {"events", testEvents},
+   {"txtiming", testTxTiming},
+   {"chunks", testChunks},
+   {"stream", testStream},
+   {"srec",   testSrec},   // Followed by the S-record files
+};
+
+int main(int argc, char *argv[]) {
+int      argNum;
+unsigned index;
+
+   if (argc < 2) {
+      fprintf(stderr, "Usage: %s test ...\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   for (argNum=1; argNum<argc; argNum++) {
+      for (index=0; index<sizeof(tests)/sizeof(tests[0]); index++) {
+         if (strcmp(argv[argNum], tests[index].name) == 0)
+            break;
+      }
+      if (index >= sizeof(tests)/sizeof(tests[0])) {
+         fprintf(stderr, "Unknown test '%s'\n", argv[argNum]);
+         return EXIT_FAILURE;
+      }
+      if (tests[index].test == testSrec) {
+         testFiles    = argv+argNum+1;
+         numTestFiles = argc-argNum-1;
+         argNum       = argc;
+      }
+      tests[index].test();
+   }
+   return (failures == 0)?EXIT_SUCCESS:EXIT_FAILURE;
+}
@@ -0,0 +1,290 @@
+/*! \file
+    \brief USBDM - HCS12 speed detection by trial and error.
+
+    Used for HC12 targets that don't support SYNC.  This code only uses the
+    BDM_CMD_xx() routines so it is shared with the host-native build.
+
+   \verbatim
+   This software was modified from \e TBDML software
+
+   USBDM
+   Copyright (C) 2007  Peter O'Donoghue
+
+   Turbo BDM Light (TBDML)
+   Copyright (C) 2005  Daniel Malik
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+   \endverbatim
+
+   \verbatim
+   Change History
+   +=======================================================================================
+   | 17 Oct 2026 | Moved from BDM.c so the host-native build can test it                   V4.10
+   | 17 Oct 2026 | HC12 speed guessing tries speeds learned per PARTID first                V4.10
+   | 14 Apr 2010 | bdmHC12_confirmSpeed() - added FDATA method                        - pgo
+   |  7 Jan 2010 | Modified bdmHC12_confirmSpeed() to reduce unnecessary probing      - pgo V4.3
+   +=======================================================================================
+   \endverbatim
+*/
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDM.h"
+#include "BDMMacros.h"
+#include "TargetDefines.h"
+#include "CmdProcessing.h"
+#include "USB.h"
+
+#if (HW_CAPABILITY&CAP_BDM)
+
+// PARTID read from HCS12 - used to confirm target connection speed and avoid needless probing
+static U16 partid = 0x00;
+
+//! Number of target speeds remembered by bdmHC12_alt_speed_detect()
+#define LEARNED_SPEEDS (6)
+
+//! Speed at which a target (identified by PARTID) was last connected
+typedef struct {
+   U16 partid;       //!< PARTID of target (0 => unknown)
+   U16 syncLength;   //!< sync_length that worked (0 => unused entry)
+} LearnedSpeed_t;
+
+//! Speeds that have worked - most recently used first
+//! Common situation is to change between a few parts & 2 speeds each (reset,running)
+static LearnedSpeed_t learnedSpeeds[LEARNED_SPEEDS] = {
+   {0, SYNC_MULTIPLE( 8000000UL)},
+   {0, SYNC_MULTIPLE(16000000UL)},
+};
+
+//! Record speed that worked for the current target (partid)
+//!
+//! @param syncLength - sync_length that worked
+//!
+static void bdmHC12_learnSpeed(U16 syncLength) {
+U8 sub;
+
+   // Find existing entry (or use last) to remove
+   for (sub=0; sub<LEARNED_SPEEDS-1; sub++) {
+      if ((learnedSpeeds[sub].syncLength == 0) ||
+          ((learnedSpeeds[sub].partid == partid) && (learnedSpeeds[sub].syncLength == syncLength)))
+         break;
+   }
+   // Move earlier entries down & insert at front (MRU)
+   for (; sub>0; sub--)
+      learnedSpeeds[sub] = learnedSpeeds[sub-1];
+   learnedSpeeds[0].partid     = partid;
+   learnedSpeeds[0].syncLength = syncLength;
+}
+
+//! Confirm communication at given Sync value.
+//! Only works on HC12 (and maybe only 1 of 'em!)
+//!
+//! @return
+//!   == \ref BDM_RC_OK  => Success \n
+//!   != \ref BDM_RC_OK  => Various errors
+//!
+#pragma MESSAGE DISABLE C4001 // Disable warnings about Condition always true
+U8 bdmHC12_confirmSpeed(U16 syncValue) {
+U8 rc;
+
+   cable_status.sync_length = syncValue;
+
+   rc = bdm_RxTxSelect(); // Drivers available for this frequency?
+   if (rc != BDM_RC_OK)
+      goto tidyUp;
+
+   rc = BDM_RC_BDM_EN_FAILED; // Assume probing failed
+   {
+      U16 probe;
+      
+      // Check if we can read a previous PARTID, if so assume still connected 
+      // and avoid further target probing
+      // This should be the usual case
+      (void)BDM12_CMD_READW(HCS12_PARTID,&probe);
+      if ((partid != 0) && (probe == partid)) {
+        return BDM_RC_OK;
+      }
+   }
+   do {
+      U16 probe;
+      // This method works for secured or unsecured devices
+      // in special mode that have a common Flash type.
+      // BUT - it may upset flash programming if done at wrong time
+      
+      // Set FDATA to 0xAA55 & read back
+      (void)BDM12_CMD_WRITEW(0x10A,0xAA55);
+      (void)BDM12_CMD_READW(0x10A,&probe);
+
+      // Read back correctly?
+      if (probe != 0xAA55)
+         break;
+
+      // Set location to 0x55AA & read back
+      (void)BDM12_CMD_WRITEW(0x10A,0x55AA);
+      (void)BDM12_CMD_READW(0x10A,&probe);
+
+      // Read back correctly?
+      if (probe != 0x55AA)
+         break;
+
+      // Update partID
+      (void)BDM12_CMD_READW(HCS12_PARTID, &partid);
+      
+      return BDM_RC_OK; // Success!
+
+   } while (0);
+
+   do {
+      U8 probe;
+      U8 originalValue;
+      // This method works for unsecured devices
+      // in special or non-special modes
+      // BUT - it may upset CCR in some (unlikely?) cases
+
+      // Get current BDMCCR
+      (void)BDM12_CMD_BDREADB(HC12_BDMCCR,&originalValue);
+
+      // Set location to 0xAA & read back
+      (void)BDM12_CMD_BDWRITEB(HC12_BDMCCR,0xAA);
+      (void)BDM12_CMD_BDREADB(HC12_BDMCCR,&probe);
+
+      // Read back correctly?
+      if (probe != 0xAA)
+         break;
+
+      // set location to 0x55 & read back
+      (void)BDM12_CMD_BDWRITEB(HC12_BDMCCR,0x55);
+      (void)BDM12_CMD_BDREADB(HC12_BDMCCR,&probe);
+
+      // Read back correctly?
+      if (probe != 0x55)
+         break;
+
+      // Restore BDMCCR
+      (void)BDM12_CMD_BDWRITEB(HC12_BDMCCR,originalValue);
+
+      // Update partID
+      (void)BDM12_CMD_READW(HCS12_PARTID, &partid);
+      
+      return BDM_RC_OK; // Success!
+      
+   } while (0);
+   
+#if 0
+   do {
+      
+   // Get current BDMSTS
+   BDM12_CMD_BDREADB(HC12_BDMSTS,&originalValue);
+
+   // Try to clear BDMSTS.ENBDM
+   BDM12_CMD_BDWRITEB(HC12_BDMSTS,originalValue&~HC12_BDMSTS_ENBDM);
+   BDM12_CMD_BDREADB(HC12_BDMSTS,&probe);
+
+   if ((probe & HC12_BDMSTS_ENBDM) != 0) // Not clear now? - Try next speed
+      goto tidyUp;
+
+   // Try to set BDMSTS.ENBDM
+   BDM12_CMD_BDWRITEB(HC12_BDMSTS,originalValue|HC12_BDMSTS_ENBDM);
+   BDM12_CMD_BDREADB(HC12_BDMSTS,&probe);
+
+   if ((probe & HC12_BDMSTS_ENBDM) == 0) // Not set now? - Try next speed
+      goto tidyUp;
+
+   return BDM_RC_OK; // Success!
+      
+   } while false;
+#endif
+
+tidyUp:
+   cable_status.sync_length  = 1;
+   cable_status.speed        = SPEED_NO_INFO; // Connection cannot be established at this speed
+   cable_status.ackn         = WAIT;    // Clear indication of ACKN feature
+   return rc;
+}
+#pragma MESSAGE DEFAULT C4001 // Disable warnings about Condition always true
+
+//! Attempt to determine target speed by trial and error
+//!
+//! Basic process used to check for communication is:
+//!   -  Attempt to modify the BDM Status register [BDMSTS] or BDM CCR Save Register [BDMCCR]
+//!
+//! The above is attempted for a range of 'nice' frequencies and then every Tx driver frequency. \n
+//! To improve performance the last few successful frequencies are remembered with the PARTID of \n
+//! the target.  These are tried first & are confirmed by a single PARTID read.  This covers the \n
+//! common case of alternating between a few parts and two frequencies [reset & clock configured] \n
+//! with a minimum number of probes.
+//!
+U8 bdmHC12_alt_speed_detect(void) {
+static const U16 typicalSpeeds[] = { // Table of 'nice' BDM speeds to try
+   SYNC_MULTIPLE( 4000000UL),  //  4 MHz
+   SYNC_MULTIPLE( 8000000UL),  //  8 MHz
+   SYNC_MULTIPLE(16000000UL),  // 16 MHz
+   SYNC_MULTIPLE(32000000UL),  // 32 MHz
+   SYNC_MULTIPLE(24000000UL),  // 24 MHz
+   SYNC_MULTIPLE(48000000UL),  // 48 MHz
+   SYNC_MULTIPLE(20000000UL),  // 20 MHz
+   SYNC_MULTIPLE( 2000000UL),  //  2 MHz
+   SYNC_MULTIPLE(10000000UL),  // 10 MHz
+   SYNC_MULTIPLE( 1000000UL),  //  1 MHz
+   SYNC_MULTIPLE(  500000UL),  // 500kHz
+   0
+   };
+int sub;
+U16 currentGuess = 0;
+U8  rc = BDM_RC_BDM_EN_FAILED;
+
+   // Try learned speeds (MRU first)
+   // Setting partid allows confirmation by a single PARTID read
+   for (sub=0; (sub<LEARNED_SPEEDS) && (learnedSpeeds[sub].syncLength != 0); sub++) {
+      partid       = learnedSpeeds[sub].partid;
+      currentGuess = learnedSpeeds[sub].syncLength;
+      rc           = bdmHC12_confirmSpeed(currentGuess);
+      if (rc == BDM_RC_OK)
+         break;
+   }
+
+   if (rc != BDM_RC_OK) {
+      // This may take a while
+      setBDMBusy();
+   }
+   
+   // Try some likely numbers!
+   for (sub=0; typicalSpeeds[sub]>0; sub++) {
+      if (rc == BDM_RC_OK)
+         break;
+      currentGuess = typicalSpeeds[sub];
+      rc           = bdmHC12_confirmSpeed(currentGuess);
+      }
+
+   // Try each Tx driver BDM frequency
+   for (sub=0; bdm_txSyncGuess((U8)sub)>0; sub++) {
+      if (rc == BDM_RC_OK)
+         break;
+      currentGuess = bdm_txSyncGuess((U8)sub);
+      rc           = bdmHC12_confirmSpeed(currentGuess);
+      }
+
+   if (rc == BDM_RC_OK) {
+      // Update speed cache (MRU)
+      bdmHC12_learnSpeed(currentGuess);
+      cable_status.speed = SPEED_GUESSED;  // Speed found by trial and error
+      return BDM_RC_OK;
+   }
+
+   cable_status.speed = SPEED_NO_INFO;  // Speed not found
+   return rc;
+}
+
+#endif // (HW_CAPABILITY&CAP_BDM)
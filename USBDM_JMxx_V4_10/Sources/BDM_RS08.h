@@ -1,14 +1,14 @@
-/*! \file
-    \brief Header file for BDM routines.
-    
- */
-#ifndef _BDM_RS08_H_
-#define _BDM_RS08_H_
-
-#if ((HW_CAPABILITY & CAP_FLASH) != 0)
-
-U8 bdmSetVpp(U8 level );
-
-#endif
-
-#endif // _BDM_RS08_H_
+/*! \file
+    \brief Header file for BDM routines.
+    
+ */
+#ifndef _BDM_RS08_H_
+#define _BDM_RS08_H_
+
+#if ((HW_CAPABILITY & CAP_FLASH) != 0)
+
+U8 bdmSetVpp(U8 level );
+
+#endif
+
+#endif // _BDM_RS08_H_
@@ -1,1050 +1,2983 @@
-/*! \file
-    \brief USBDM - Main command procedure for executing BDM commands.
-
-   This file processes the commands received over the USB link from the host
-
-   \verbatim
-   This software was modified from \e TBLCF software
-   This software was modified from \e TBDML software
-
-   USBDM
-   Copyright (C) 2007  Peter O'Donoghue
-
-   Turbo BDM Light
-   Copyright (C) 2005  Daniel Malik
-
-   Turbo BDM Light ColdFire
-   Copyright (C) 2005  Daniel Malik
-
-   This program is free software; you can redistribute it and/or modify
-   it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2 of the License, or
-   (at your option) any later version.
-
-   This program is distributed in the hope that it will be useful,
-   but WITHOUT ANY WARRANTY; without even the implied warranty of
-   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-   GNU General Public License for more details.
-
-   You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
-   \endverbatim
-
-   \verbatim
-   Change History
-   +===============================================================================================
-   | 20 May 2012 | Extended firmware version information                                    V4.9.5
-   |  8 Apr 2012 | Fixed missing PST status in makeStatusWord()                       - pgo V4.7.4
-   | 20 Apr 2011 | Added DE to f_CMD_USBDM_CONTROL_PINS                               - pgo V4.7
-   | 20 Apr 2011 | Added CMD_USBDM_SET_VDD                                            - pgo V4.6
-   | 20 Apr 2011 | Added CMD_USBDM_CONTROL_PINS                                       - pgo V4.6
-   | 31 Mar 2011 | Added command toggle                                               - pgo V4.6
-   | 24 Feb 2011 | Extended auto-connect options                                      - pgo V4.6
-   | 26 Nov 2010 | Modified f_CMD_SET_OPTIONS so changes do NOT have immediate effect - pgo V4.3
-   |  8 Aug 2010 | Added supported target check                                       - pgo 
-   |  8 Aug 2010 | Re-arranged target execution tables & added DSC                    - pgo 
-   | 21 Jun 2010 | Added T_MC56F800xx Type                                            - pgo
-   | 20 May 2010 | Added JTAG as separate command table                               - pgo
-   | 10 May 2010 | Many changes in Vpp/RS08 code (deleted!)                           - pgo
-   |  1 May 2010 | Action option changes immediately in f_CMD_SET_OPTIONS()           - pgo
-   |    Oct 2009 | Extended status information available                              - pgo
-   |    Sep 2009 | Major changes for V2                                               - pgo
-   -=======================================================================================
-   |  3 Feb 2009 | Extended bdm_setInterfaceLeve[]                                    - pgo
-   | 20 Jan 2009 | Merged HCS/CFV1 code from USBDM                                    - pgo
-   | 13 Jan 2009 | Moved CFVx commands to separate file                               - pgo
-   | 12 Jan 2009 | Changed to dispatch table & individual functions                   - pgo
-   |  1 Jan 2009 | Ported to JMxx from JB16 TBLCF code                                - pgo
-   +=======================================================================================
-   \endverbatim
-*/
-#include <string.h>
-#include "Common.h"
-#include "Configure.h"
-#include "Commands.h"
-#include "BDMCommon.h"
-#include "BDM_CF.h"
-#include "BDM_RS08.h"
-#include "BDM.h"
-#include "SWD.h"
-#include "USB.h"
-#include "ICP.h"
-#include "CmdProcessing.h"
-#include "CmdProcessingHCS.h"
-#include "CmdProcessingCFVx.h"
-#include "CmdProcessingCFV1.h"
-#include "CmdProcessingSWD.h"
-
-#ifdef __HC08__
-#pragma DATA_SEG __SHORT_SEG Z_PAGE
-#endif // __HC08__
-//! Status of the BDM
-//!
-//! see \ref CableStatus_t
-CableStatus_t cable_status = { T_OFF };
-
-//! Options for the BDM
-//!
-//! see \ref BDM_Option_t
-BDM_Option_t bdm_option = {
-   BDM_TARGET_VDD_OFF,  //!< Target Vdd (off, 3.3V or 5V)
-   FALSE,               //!< Cycle target Power when resetting
-   FALSE,               //!< Cycle target Power if connection problems (when resetting?)
-   FALSE,               //!< Leave target power on when exiting
-   AUTOCONNECT_STATUS,  //!< Automatically re-connect to target (for speed change)
-   TRUE,                //!< Guess speed for target w/o ACKN
-   CS_DEFAULT,          //!< Use alternative BDM clock source in target
-   FALSE,               //!< Use RESET signal on BDM interface
-   {0}                  //   Reserved
-};
-#pragma DATA_SEG DEFAULT
-
-//! Buffer for Rx and Tx of commands & results
-U8  commandBuffer[MAX_COMMAND_SIZE];
-
-#ifdef __HC08__
-#pragma DATA_SEG __SHORT_SEG Z_PAGE
-#endif // __HC08__
-static U8  commandStatus;      //!< Error code from last/current command
-U8  returnSize;                //!< Size of command result
-#pragma DATA_SEG DEFAULT
-
-//==========================================================================
-// Modeless commands
-//==========================================================================
-
-//! Creates status byte
-//!
-//! @return 16-bit status byte \ref StatusBitMasks_t
-//!
-U16 makeStatusWord(void) {
-U16 status = 0;
-
-   // Target specific checks
-   switch (cable_status.target_type) {
-#if (HW_CAPABILITY&CAP_CFVx_HW) && (TARGET_CAPABILITY&CAP_PST)
-   case T_CFVx : 
-	  if (ALLPST_IS_HIGH) {
-         status |= S_HALT;  // Target is halted
-	  }
-      break;
-#endif
-#if HW_CAPABILITY&CAP_BDM	   
-   case T_HC12:
-   case T_HCS08:
-   case T_RS08:
-   case T_CFV1:
-	  if (cable_status.ackn==ACKN) {  // Target supports ACKN and the feature is enabled ?
-		 status |= S_ACKN;
-	  }
-      switch (cable_status.speed) {
-//      case SPEED_NO_INFO       : status |= S_NOT_CONNECTED;  break; 
-        case SPEED_USER_SUPPLIED : status |= S_USER_DONE;      break; 
-        case SPEED_SYNC          : status |= S_SYNC_DONE;      break; 
-        case SPEED_GUESSED       : status |= S_GUESS_DONE;     break; 
-      }
-	  break;
-#endif	  
-   }
-#if (HW_CAPABILITY&CAP_RST_IO)
-   if (RESET_IS_HIGH) {
-      status |= S_RESET_STATE;   // The RSTO pin is currently high
-   }
-   if (cable_status.reset==RESET_DETECTED) {
-      status |= S_RESET_DETECT;                    // The target was recently reset externally
-      if (RESET_IS_HIGH) {
-         cable_status.reset = NO_RESET_ACTIVITY;   // Clear the flag if reset pin has returned high
-      }
-   }
-#endif
-#if (HW_CAPABILITY&CAP_VDDSENSE)
-   switch (cable_status.power) {    // Target has power ?
-//    case BDM_TARGET_VDD_NONE : status |= S_POWER_NONE; break;
-      case BDM_TARGET_VDD_ERR  : status |= S_POWER_ERR;  break;
-      case BDM_TARGET_VDD_INT  : status |= S_POWER_INT;  break;
-      case BDM_TARGET_VDD_EXT  : status |= S_POWER_EXT;  break;
-   }
-#else
-   // Assume power present
-   status |= S_POWER_EXT;
-#endif
-#if (HW_CAPABILITY&CAP_FLASH)
-   switch (cable_status.flashState) {
-//    case BDM_TARGET_VPP_OFF     : status |= S_VPP_OFF;      break;
-      case BDM_TARGET_VPP_STANDBY : status |= S_VPP_STANDBY;  break;
-      case BDM_TARGET_VPP_ON      : status |= S_VPP_ON;       break;
-      case BDM_TARGET_VPP_ERROR   : status |= S_VPP_ERR;      break;
-   }
-#endif
-   return status;
-}
-
-//! Optionally re-connects with target
-//!
-//! @param when indicates situation in which the routine is being called\n
-//!       AUTOCONNECT_STATUS  - being called during status query
-//!	      AUTOCONNECT_ALWAYS, - being called before command execution
-//!
-//! @return
-//!    == \ref BDM_RC_OK => success       \n
-//!    != \ref BDM_RC_OK => error 
-//! 
-U8 optionalReconnect(U8 when) {
-U8 rc = BDM_RC_OK;
-   (void)when; // remove warning
-#if HW_CAPABILITY&CAP_BDM	 
-   switch (cable_status.target_type) {
-   case T_HC12:
-	  if (cable_status.speed == SPEED_USER_SUPPLIED) //   User has specified speed
-         break;
-	  // Fall through
-   case T_RS08:
-   case T_HCS08:
-   case T_CFV1:
-	   if (bdm_option.autoReconnect == when) // If auto re-connect enabled at this time AND
-		  rc = bdm_physicalConnect();        // Make sure of connection
-	   break;
-   default: ;
-   }
-#endif
-   return rc;
-}
-
-//! Dummy routine for unused slots in command table
-//!
-//! @return
-//!    BDM_RC_ILLEGAL_COMMAND => illegal command
-//!
-U8 f_CMD_ILLEGAL(void) {
-   return BDM_RC_ILLEGAL_COMMAND;
-}
-
-//! Return status from last command received
-//!
-//! @return
-//!   status from last command
-//!
-U8 f_CMD_GET_COMMAND_STATUS(void) {
-   return commandStatus;
-}
-
-//! Various debugging & testing commands
-//!
-//! @note
-//!   commandBuffer           \n
-//!    - [1..N] = various commands
-//!
-//! @return
-//!    error code
-//!
-U8 f_CMD_DEBUG(void) {
-
-DebugSubCommands subCommand = commandBuffer[2];
-
-   switch ((U8)subCommand) {
-#if (HW_CAPABILITY&CAP_BDM)     
-      case BDM_DBG_ACKN: // try the ACKN feature
-         bdm_acknInit();
-         commandBuffer[1] = (U8) makeStatusWord(); // return the status byte
-         returnSize = 2;
-         return BDM_RC_OK;
-
-      case BDM_DBG_SYNC: { // try the sync feature
-         U8 rc;
-         rc = bdm_syncMeasure();
-         if (rc != BDM_RC_OK)
-            return rc;
-         commandBuffer[1] = (U8)makeStatusWord(); // return the status byte
-         (*(U16*)(commandBuffer+2)) = cable_status.sync_length;
-         returnSize = 4;
-         }
-         return BDM_RC_OK;
-
-      case BDM_DBG_TESTPORT: // Check port I/O timing - hangs USB interface
-         bdm_checkTiming();
-         return BDM_RC_OK;
-#endif
-#if (HW_CAPABILITY & CAP_FLASH)
-      case BDM_DBG_VPP_OFF: // Programming voltage off
-         return bdmSetVpp(BDM_TARGET_VPP_OFF );
-
-      case BDM_DBG_VPP_ON:
-         // Programming voltage on (requires FLASH12V on first)
-         return bdmSetVpp(BDM_TARGET_VPP_ON );
-
-      case BDM_DBG_FLASH12V_OFF: // 12V charge pump off
-         return bdmSetVpp(BDM_TARGET_VPP_OFF );
-
-      case BDM_DBG_FLASH12V_ON:  // 12V charge pump on
-         return bdmSetVpp(BDM_TARGET_VPP_STANDBY );
-#endif
-#if (HW_CAPABILITY & CAP_VDDCONTROL)
-      case BDM_DBG_VDD_OFF: // Target Vdd voltage off
-         VDD_OFF();
-         return BDM_RC_OK;
-
-      case BDM_DBG_VDD3_ON: // Target Vdd voltage on
-         VDD3_ON();
-         return BDM_RC_OK;
-
-      case BDM_DBG_VDD5_ON: // Target Vdd voltage on
-         VDD5_ON();
-         return BDM_RC_OK;
-
-      case BDM_DBG_CYCLE_POWER: // Cycle power to target
-         return bdm_cycleTargetVdd(RESET_SPECIAL);
-#endif
-#if (HW_CAPABILITY & CAP_VDDSENSE)
-      case BDM_DBG_MEASURE_VDD: // Measure Target Vdd
-         (*(U16*)(commandBuffer+1)) = bdm_targetVddMeasure(); // return the value
-         returnSize = 3;
-         return BDM_RC_OK;
-#endif
-#if defined(INLINE_ACKN)
-      case BDM_DBG_TESTWAITS:
-         bdm_checkWaitTiming();
-         return BDM_RC_OK;
-#endif
-
-      case BDM_DBG_TESTALTSPEED:
-         return BDM_RC_OK;
-
-#if (DEBUG&STACK_DEBUG)
-      case BDM_DBG_STACKSIZE: // Measure stack size
-         {
-         extern char  __SEG_START_SSTACK[];     // Bottom of stack space
-         extern char  __SEG_END_SSTACK[];       // Top of stack space
-         char *stackProbe = __SEG_START_SSTACK; // Probe for stack RAM
-
-         while (*++stackProbe == 0) { // Find 1st used (non-zero) byte on stack
-         }
-         (*(U16*)(commandBuffer+1)) = (U16) __SEG_END_SSTACK - (U16) stackProbe;
-         returnSize = 3;
-         return BDM_RC_OK;
-         }
-#endif // (DEBUG&STACK_DEBUG)
-#if (HW_CAPABILITY&CAP_BDM)     
-      case BDM_DBG_TESTBDMTX: // Test BDM Tx routine
-         return bdm_testTx(commandBuffer[3]);
-#endif
-#if HW_CAPABILITY & CAP_SWD_HW
-      case   BDM_DBG_SWD: //!< - Test SWD functions
-    	 return swd_test();
-#endif
-   } // switch
-   return BDM_RC_ILLEGAL_PARAMS;
-}
-
-//! Set various options
-//!
-//! @note
-//!   commandBuffer\n
-//!   - [2..N] = options (image of \ref BDM_Option_t)
-//!
-//!  @return
-//!    BDM_RC_OK => success
-//!
-U8 f_CMD_SET_OPTIONS(void) {
-U8 rc = BDM_RC_OK;
-   // Save BDM Options
-   (void)memcpy((U8*)&bdm_option, commandBuffer+2, sizeof(bdm_option));
-   return rc;
-}
-
-//! Returns capability vector for hardware
-//! @return
-//!  commandBuffer                                                \n
-//!   - [1..2] = BDM capability, see \ref HardwareCapabilities_t  \n
-//!   - [3..4] = Maximum command buffer size
-//!
-U8 f_CMD_GET_CAPABILITIES(void) {
-	// Note: CAP_HCS08 & CAP_CFV1 are returned inverted for backwards compatibility
-	// Inversion is hidden by driver!
-   *(U16*)(commandBuffer+1) = TARGET_CAPABILITY^(CAP_HCS08|CAP_CFV1);  // Returns 16-bit value
-   *(U16*)(commandBuffer+3) = MAX_COMMAND_SIZE;
-   commandBuffer[5] = VERSION_MAJOR;             // Extended firmware version number nn.nn.nn
-   commandBuffer[6] = VERSION_MINOR;
-   commandBuffer[7] = VERSION_MICRO;
-   returnSize = 8;
-   return BDM_RC_OK;
-}
-
-//! Return status of BDM communication
-//!
-//! @note
-//!   commandBuffer\n
-//!  - [1..2] = BDM status
-//!
-U8 f_CMD_GET_BDM_STATUS(void) {
-U16 word;
-
-   // Update power status
-   (void)bdm_checkTargetVdd();
-   
-   word = makeStatusWord();
-
-   commandBuffer[1] = (U8) (word>>8);
-   commandBuffer[2] = (U8) word;
-   returnSize  = 3;
-
-   return BDM_RC_OK;
-}
-
-void getPinStatus(void) {
-U16 status;
-
-   status = RESET_IS_LOW?PIN_RESET_LOW:PIN_RESET_HIGH;
-   
-   commandBuffer[1] = (U8) (status>>8);
-   commandBuffer[2] = (U8) status;
-   returnSize  = 3;
-}
-
-//! Directly control pins
-//!
-//! @note
-//!   commandBuffer\n
-//!     Entry: [2..3] = control value\n
-//!     Exit:  [1..2] = pin values (MSB unused) - not yet implemented
-//!
-U8 f_CMD_CONTROL_PINS(void) {
-
-   U16 control = *(U16*)(commandBuffer+2);
-   
-   // Set up for OK return
-   commandBuffer[1] = 0;
-   commandBuffer[2] = 0;
-   returnSize  = 3;
-
-   if (control == PIN_NOCHANGE) {
-	   getPinStatus();
-	   return BDM_RC_OK;
-   }
-   if (control == PIN_RELEASE) {
-	   switch (cable_status.target_type) {
-#if HW_CAPABILITY&CAP_BDM	 	   
-	   case T_HC12 :  
-	   case T_HCS08 :
-	   case T_RS08 :
-	   case T_CFV1 :
-		   bdmHCS_interfaceIdle();
-		   break;
-#endif		   
-#if (HW_CAPABILITY&CAP_CFVx_HW)
-	   case T_CFVx :
-		   bdmcf_interfaceIdle();
-		   break;
-#endif
-#if (HW_CAPABILITY&CAP_JTAG_HW)
-	   case T_JTAG :
-	   case T_ARM_JTAG :
-	   case T_MC56F80xx :
-		   jtag_interfaceIdle();
-		   break;
-#endif
-#if (HW_CAPABILITY&CAP_SWD_HW)
-	   case T_ARM_SWD :
-		   swd_interfaceIdle();
-		   break;
-#endif
-	   case T_OFF :
-	   default:
-		   return BDM_RC_ILLEGAL_COMMAND;
-	   }
-	   getPinStatus();
-	   return BDM_RC_OK;
-   }
-   // Restrict control to mode specific active pins
-   switch (cable_status.target_type) {
-   case T_HC12 :  
-   case T_HCS08 :
-   case T_RS08 :
-   case T_CFV1 :
-	   if (control & ~(PIN_BKGD|PIN_RESET))
-		   return BDM_RC_ILLEGAL_PARAMS;
-	   break;
-#if (HW_CAPABILITY&CAP_CFVx_HW)
-   case T_CFVx :
-	   if (control & ~(PIN_TA|PIN_RESET|PIN_BKPT))
-		   return BDM_RC_ILLEGAL_PARAMS;
-	   break;
-#endif
-#if (HW_CAPABILITY&CAP_JTAG_HW)
-   case T_MC56F80xx :
-	   if (control & ~(PIN_TRST|PIN_RESET|PIN_DE))
-		   return BDM_RC_ILLEGAL_PARAMS;
-	   break;
-   case T_JTAG :
-   case T_ARM_JTAG :
-	   if (control & ~(PIN_TRST|PIN_RESET))
-		   return BDM_RC_ILLEGAL_PARAMS;
-	   break;
-#endif	   
-#if (HW_CAPABILITY&CAP_SWD_HW)
-	   case T_ARM_SWD :
-		   if (control & ~(PIN_SWD|PIN_RESET))
-			   return BDM_RC_ILLEGAL_PARAMS;
-		   break;
-#endif
-   case T_OFF :
-   default:
-	   return BDM_RC_ILLEGAL_PARAMS;
-   }
-
-#if (HW_CAPABILITY & CAP_BDM)
-   switch (control & PIN_BKGD) {
-   case PIN_BKGD_3STATE : 
-	   BDM_3STATE();    // Disable BKGD buffer, BKGD = X
-       break;
-   case PIN_BKGD_LOW :
-	   BDM_LOW();       // Enable BKGD buffer,  BKGD = 0
-       break;
-   case PIN_BKGD_HIGH :
-	   BDM_HIGH();      // Enable BKGD buffer,  BKGD = 1
-       break;
-   }
-#endif
-#if (HW_CAPABILITY & CAP_RST_IO)
-   switch (control & PIN_RESET) {
-   case PIN_RESET_3STATE : 
-	   RESET_3STATE(); 
-	   WAIT_WITH_TIMEOUT_S(2, (RESET_IS_HIGH));
-	   if (RESET_IS_LOW) { 
-          return(BDM_RC_RESET_TIMEOUT_RISE);
-	   }
-	   break;
-   case PIN_RESET_LOW :
-	   RESET_LOW(); 
-	   break;
-   }
-#endif
-   
-#if (HW_CAPABILITY&CAP_JTAG_HW)
-   switch(control&PIN_TRST) {
-   case PIN_TRST_3STATE:
-	   TRST_3STATE();
-	   break;
-   case PIN_TRST_LOW:
-	   TRST_LOW();
-	   break;
-   }
-#endif
-#if (HW_CAPABILITY&CAP_CFVx_HW)
-   switch (control & PIN_TA) {
-   case PIN_TA_3STATE : 
-	   TA_3STATE(); 
-	   break;
-   case PIN_TA_LOW :
-	   TA_LOW(); 
-	   break;
-   }
-
-   switch(control&PIN_BKPT) {
-   case PIN_BKPT_3STATE:
-	   BKPT_HIGH(); // should be 3-state!
-	   break;
-   case PIN_BKPT_LOW:
-	   BKPT_LOW();
-	   break;
-   }
-#endif
-   
-#if (HW_CAPABILITY & CAP_SWD_HW)
-   switch (control & PIN_SWD) {
-   case PIN_SWD_3STATE : 
-	   SWD_3STATE();    // Disable SWD buffer, SWDIO = Z
-       break;
-   case PIN_SWD_LOW :
-	   SWD_LOW();       // Enable SWD buffer,  SWDIO = 0
-       break;
-   case PIN_SWD_HIGH :
-	   SWD_HIGH();      // Enable SWD buffer,  SWDIO = 1
-       break;
-   }
-#endif
-   getPinStatus();
-   return BDM_RC_OK;
-}
-
-//! Directly control Target Vdd
-//!
-//! @note
-//!   commandBuffer\n
-//!     Entry: [2..3] = control value (MSB unused)\n
-//!     Exit:  none
-//!
-U8 f_CMD_SET_VDD(void) {
-   U8 rc;
-#if (HW_CAPABILITY&CAP_VDDCONTROL)
-   bdm_option.targetVdd = commandBuffer[3];
-   rc = bdm_setTargetVdd();
-#else
-   rc = bdm_checkTargetVdd();
-#endif
-   // It's OK if there is no external power at the moment
-   if ((commandBuffer[3] == BDM_TARGET_VDD_OFF) && 
-       (rc == BDM_RC_VDD_NOT_PRESENT))
-	   rc = BDM_RC_OK;
-   return rc;
-}
-
-//=================================================
-// Command Dispatch code
-//=================================================
-//! Ptr to command function
-typedef U8 (*FunctionPtr)(void);
-
-//! Structure representing a set of function ptrs 
-typedef struct {
-   U8 firstCommand;					//!< First command value accepted
-   U8 size;             			//!< Size of command structure
-   const FunctionPtr *functions; 	//!< Ptr to commands
-} FunctionPtrs;
-
-extern U8 f_CMD_SET_TARGET(void);
-
-static const FunctionPtr commonFunctionPtrs[] = {
-   // Common to all targets
-   f_CMD_GET_COMMAND_STATUS         ,//= 0,  CMD_USBDM_GET_COMMAND_STATUS
-   f_CMD_SET_TARGET                 ,//= 1,  CMD_USBDM_SET_TARGET
-   f_CMD_SET_VDD                    ,//= 2,  CMD_USBDM_SET_VDD
-#if (DEBUG&DEBUG_COMMANDS)
-   f_CMD_DEBUG                      ,//= 3,  CMD_USBDM_DEBUG
-#else
-   f_CMD_ILLEGAL                    ,//= 3,  CMD_USBDM_DEBUG - disabled
-#endif
-   f_CMD_GET_BDM_STATUS             ,//= 4,  CMD_USBDM_GET_BDM_STATUS
-   f_CMD_GET_CAPABILITIES           ,//= 5,  CMD_USBDM_GET_CAPABILITIES
-   f_CMD_SET_OPTIONS                ,//= 6,  CMD_USBDM_SET_OPTIONS
-// f_CMD_GET_SETTINGS               ,//= 7,  CMD_USBDM_GET_SETTINGS
-   f_CMD_ILLEGAL                    ,//= 7,  Reserved
-   f_CMD_CONTROL_PINS               ,//= 8,  CMD_USBDM_CONTROL_PINS
-   f_CMD_ILLEGAL                    ,//= 9,  Reserved
-   f_CMD_ILLEGAL                    ,//= 10, Reserved
-   f_CMD_ILLEGAL                    ,//= 11, Reserved
-   f_CMD_ILLEGAL                    ,//= 12, CMD_USBDM_GET_VER (EP0)
-   f_CMD_ILLEGAL                    ,//= 13, Reserved
-   f_CMD_ILLEGAL                    ,//= 14, CMD_USBDM_ICP_BOOT (EP0)
-};
-
-#if (TARGET_CAPABILITY&CAP_HCS12)
-static const FunctionPtr HCS12functionPtrs[] = {
-   // Target specific versions
-   f_CMD_CONNECT                    ,//= 15, CMD_USBDM_CONNECT
-   f_CMD_SET_SPEED                  ,//= 16, CMD_USBDM_SET_SPEED
-   f_CMD_GET_SPEED                  ,//= 17, CMD_USBDM_GET_SPEED
-
-   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
-   f_CMD_ILLEGAL                    ,//= 19, RESERVED
-
-   f_CMD_READ_STATUS_REG            ,//= 20, CMD_USBDM_READ_STATUS_REG
-   f_CMD_WRITE_CONTROL_REG          ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
-
-   f_CMD_RESET                      ,//= 22, CMD_USBDM_TARGET_RESET
-   f_CMD_STEP                       ,//= 23, CMD_USBDM_TARGET_STEP
-   f_CMD_GO                         ,//= 24, CMD_USBDM_TARGET_GO
-   f_CMD_HALT                       ,//= 25, CMD_USBDM_TARGET_HALT
-
-   f_CMD_HCS12_WRITE_REG            ,//= 26, CMD_USBDM_WRITE_REG
-   f_CMD_HCS12_READ_REG             ,//= 27, CMD_USBDM_READ_REG
-
-   f_CMD_ILLEGAL                    ,//= 28, CMD_USBDM_WRITE_CREG
-   f_CMD_ILLEGAL                    ,//= 29, CMD_USBDM_READ_CREG
-
-   f_CMD_WRITE_BD                   ,//= 30, CMD_USBDM_WRITE_DREG
-   f_CMD_READ_BD                    ,//= 31, CMD_USBDM_READ_DREG
-
-   f_CMD_HCS12_WRITE_MEM            ,//= 32, CMD_USBDM_WRITE_MEM
-   f_CMD_HCS12_READ_MEM             ,//= 33, CMD_USBDM_READ_MEM
-   };
-static const FunctionPtrs HCS12FunctionPointers = {CMD_USBDM_CONNECT,
-                                                   sizeof(HCS12functionPtrs)/sizeof(FunctionPtr),
-                                                   HCS12functionPtrs};
-#endif
-
-#if (TARGET_CAPABILITY&(CAP_HCS08|CAP_RS08))
-static const FunctionPtr HCS08functionPtrs[] = {
-   // Target specific versions
-   f_CMD_CONNECT                    ,//= 15, CMD_USBDM_CONNECT
-   f_CMD_SET_SPEED                  ,//= 16, CMD_USBDM_SET_SPEED
-   f_CMD_GET_SPEED                  ,//= 17, CMD_USBDM_GET_SPEED
-
-   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
-   f_CMD_ILLEGAL                    ,//= 19, RESERVED
-
-   f_CMD_READ_STATUS_REG            ,//= 20, CMD_USBDM_READ_STATUS_REG
-   f_CMD_WRITE_CONTROL_REG          ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
-
-   f_CMD_RESET                      ,//= 22, CMD_USBDM_TARGET_RESET
-   f_CMD_STEP                       ,//= 23, CMD_USBDM_TARGET_STEP
-   f_CMD_GO                         ,//= 24, CMD_USBDM_TARGET_GO
-   f_CMD_HALT                       ,//= 25, CMD_USBDM_TARGET_HALT
-
-   f_CMD_HCS08_WRITE_REG            ,//= 26, CMD_USBDM_WRITE_REG
-   f_CMD_HCS08_READ_REG             ,//= 27, CMD_USBDM_READ_REG
-
-   f_CMD_ILLEGAL                    ,//= 28, CMD_USBDM_WRITE_CREG
-   f_CMD_ILLEGAL                    ,//= 29, CMD_USBDM_READ_CREG
-
-   f_CMD_WRITE_BKPT                 ,//= 30, CMD_USBDM_WRITE_DREG
-   f_CMD_READ_BKPT                  ,//= 31, CMD_USBDM_READ_DREG
-
-   f_CMD_HCS08_WRITE_MEM            ,//= 32, CMD_USBDM_WRITE_MEM
-   f_CMD_HCS08_READ_MEM             ,//= 33, CMD_USBDM_READ_MEM
-
-#if (TARGET_CAPABILITY & CAP_RS08)
-   f_CMD_ILLEGAL                    ,//= 34, CMD_USBDM_TRIM_CLOCK - obsolete
-   f_CMD_ILLEGAL                    ,//= 35, CMD_USBDM_RS08_FLASH_ENABLE - obsolete
-   f_CMD_ILLEGAL                    ,//= 36, CMD_USBDM_RS08_FLASH_STATUS - obsolete
-   f_CMD_ILLEGAL                    ,//= 37, CMD_USBDM_RS08_FLASH_DISABLE - obsolete
-   f_CMD_ILLEGAL                    ,//= 38, CMD_USBDM_JTAG_GOTORESET
-   f_CMD_ILLEGAL                    ,//= 39, CMD_USBDM_JTAG_GOTOSHIFT
-   f_CMD_ILLEGAL                    ,//= 40, CMD_USBDM_JTAG_WRITE
-   f_CMD_ILLEGAL                    ,//= 41, CMD_USBDM_JTAG_READ
-   f_CMD_SET_VPP                    ,//= 42, CMD_USBDM_SET_VPP
-#endif
-   };
-static const FunctionPtrs HCS08FunctionPointers = {CMD_USBDM_CONNECT,
-                                                   sizeof(HCS08functionPtrs)/sizeof(FunctionPtr),
-                                                   HCS08functionPtrs};
-#endif
-
-#if (TARGET_CAPABILITY&CAP_CFV1)
-static const FunctionPtr CFV1functionPtrs[] = {
-   // Target specific versions
-   f_CMD_CONNECT                    ,//= 15, CMD_USBDM_CONNECT
-   f_CMD_SET_SPEED                  ,//= 16, CMD_USBDM_SET_SPEED
-   f_CMD_GET_SPEED                  ,//= 17, CMD_USBDM_GET_SPEED
-
-   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
-   f_CMD_ILLEGAL                    ,//= 19, RESERVED
-
-   f_CMD_READ_STATUS_REG            ,//= 20, CMD_USBDM_READ_STATUS_REG
-   f_CMD_WRITE_CONTROL_REG          ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
-
-   f_CMD_RESET                      ,//= 22, CMD_USBDM_TARGET_RESET
-   f_CMD_STEP                       ,//= 23, CMD_USBDM_TARGET_STEP
-   f_CMD_GO                         ,//= 24, CMD_USBDM_TARGET_GO
-   f_CMD_HALT                       ,//= 25, CMD_USBDM_TARGET_HALT
-
-   f_CMD_CF_WRITE_REG               ,//= 26, CMD_USBDM_WRITE_REG
-   f_CMD_CF_READ_REG                ,//= 27  CMD_USBDM_READ_REG
-
-   f_CMD_CF_WRITE_CREG              ,//= 28  CMD_USBDM_WRITE_CREG
-   f_CMD_CF_READ_CREG               ,//= 29  CMD_USBDM_READ_CREG
-
-   f_CMD_CF_WRITE_DREG              ,//= 30  CMD_USBDM_WRITE_DREG
-   f_CMD_CF_READ_DREG               ,//= 31  CMD_USBDM_READ_DREG
-
-   f_CMD_CF_WRITE_MEM               ,//= 32  CMD_USBDM_WRITE_MEM
-   f_CMD_CF_READ_MEM                ,//= 33  CMD_USBDM_READ_MEM
-   };
-static const FunctionPtrs CFV1FunctionPointers  = {CMD_USBDM_CONNECT,
-                                                   sizeof(CFV1functionPtrs)/sizeof(FunctionPtr),
-                                                   CFV1functionPtrs};
-#endif
-
-#if (TARGET_CAPABILITY&CAP_CFVx)
-static const FunctionPtr CFVxfunctionPtrs[] = {
-   // Target specific versions
-   f_CMD_CFVx_RESYNC                ,//= 15, CMD_USBDM_CONNECT
-   f_CMD_SPI_SET_SPEED              ,//= 16, CMD_USBDM_SET_SPEED
-   f_CMD_SPI_GET_SPEED              ,//= 17, CMD_USBDM_GET_SPEED
-
-   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
-   f_CMD_ILLEGAL                    ,//= 19, RESERVED
-
-   f_CMD_CFVx_READ_STATUS_REG       ,//= 20, CMD_USBDM_READ_STATUS_REG
-   f_CMD_ILLEGAL                    ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
-
-   f_CMD_CFVx_RESET                 ,//= 22, CMD_USBDM_TARGET_RESET
-   f_CMD_CFVx_STEP                  ,//= 23, CMD_USBDM_TARGET_STEP
-   f_CMD_CFVx_GO                    ,//= 24, CMD_USBDM_TARGET_GO
-   f_CMD_CFVx_HALT                  ,//= 25, CMD_USBDM_TARGET_HALT
-
-   f_CMD_CFVx_WRITE_REG             ,//= 26, CMD_USBDM_WRITE_REG
-   f_CMD_CFVx_READ_REG              ,//= 27  CMD_USBDM_READ_REG
-
-   f_CMD_CFVx_WRITE_CREG            ,//= 28  CMD_USBDM_WRITE_CREG
-   f_CMD_CFVx_READ_CREG             ,//= 29  CMD_USBDM_READ_CREG
-
-   f_CMD_CFVx_WRITE_DREG            ,//= 30  CMD_USBDM_WRITE_DREG
-   f_CMD_CFVx_READ_DREG             ,//= 31  CMD_USBDM_READ_DREG
-
-   f_CMD_CFVx_WRITE_MEM             ,//= 32  CMD_USBDM_WRITE_MEM
-   f_CMD_CFVx_READ_MEM              ,//= 33  CMD_USBDM_READ_MEM
-
-   f_CMD_ILLEGAL                    ,//= 34, CMD_USBDM_TRIM_CLOCK
-   f_CMD_ILLEGAL                    ,//= 35, CMD_USBDM_RS08_FLASH_ENABLE
-   f_CMD_ILLEGAL                    ,//= 36, CMD_USBDM_RS08_FLASH_STATUS
-   f_CMD_ILLEGAL                    ,//= 37, CMD_USBDM_RS08_FLASH_DISABLE
-   };
-static const FunctionPtrs CFVxFunctionPointers  = {CMD_USBDM_CONNECT,
-                                                   sizeof(CFVxfunctionPtrs)/sizeof(FunctionPtr),
-                                                   CFVxfunctionPtrs};
-#endif 
-
-#if (TARGET_CAPABILITY&(CAP_DSC|CAP_JTAG|CAP_ARM_JTAG))
-static const FunctionPtr JTAGfunctionPtrs[] = {
-   // Target specific versions
-   f_CMD_ILLEGAL                    ,//= 15, CMD_USBDM_CONNECT
-   f_CMD_SPI_SET_SPEED              ,//= 16, CMD_USBDM_SET_SPEED
-   f_CMD_SPI_GET_SPEED              ,//= 17, CMD_USBDM_GET_SPEED
-   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
-   f_CMD_ILLEGAL                    ,//= 19, RESERVED
-   f_CMD_ILLEGAL                    ,//= 20, CMD_USBDM_READ_STATUS_REG
-   f_CMD_ILLEGAL                    ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
-   f_CMD_JTAG_RESET                 ,//= 22, CMD_USBDM_TARGET_RESET
-   f_CMD_ILLEGAL                    ,//= 23, CMD_USBDM_TARGET_STEP
-   f_CMD_ILLEGAL                    ,//= 24, CMD_USBDM_TARGET_GO
-   f_CMD_ILLEGAL                    ,//= 25, CMD_USBDM_TARGET_HALT
-   f_CMD_ILLEGAL                    ,//= 26, CMD_USBDM_WRITE_REG
-   f_CMD_ILLEGAL                    ,//= 27  CMD_USBDM_READ_REG
-   f_CMD_ILLEGAL                    ,//= 28  CMD_USBDM_WRITE_CREG
-   f_CMD_ILLEGAL                    ,//= 29  CMD_USBDM_READ_CREG
-   f_CMD_ILLEGAL                    ,//= 30  CMD_USBDM_WRITE_DREG
-   f_CMD_ILLEGAL                    ,//= 31  CMD_USBDM_READ_DREG
-   f_CMD_ILLEGAL                    ,//= 32  CMD_USBDM_WRITE_MEM
-   f_CMD_ILLEGAL                    ,//= 33  CMD_USBDM_READ_MEM
-   f_CMD_ILLEGAL                    ,//= 34, CMD_USBDM_TRIM_CLOCK
-   f_CMD_ILLEGAL                    ,//= 35, CMD_USBDM_RS08_FLASH_ENABLE
-   f_CMD_ILLEGAL                    ,//= 36, CMD_USBDM_RS08_FLASH_STATUS
-   f_CMD_ILLEGAL                    ,//= 37, CMD_USBDM_RS08_FLASH_DISABLE
-   f_CMD_JTAG_GOTORESET             ,//= 38, CMD_USBDM_JTAG_GOTORESET
-   f_CMD_JTAG_GOTOSHIFT             ,//= 39, CMD_USBDM_JTAG_GOTOSHIFT
-   f_CMD_JTAG_WRITE                 ,//= 40, CMD_USBDM_JTAG_WRITE
-   f_CMD_JTAG_READ                  ,//= 41, CMD_USBDM_JTAG_READ
-   f_CMD_ILLEGAL                    ,//= 42, CMD_USBDM_SET_VPP
-   f_CMD_JTAG_READ_WRITE            ,//= 43, CMD_USBDM_JTAG_READ_WRITE
-   f_CMD_JTAG_EXECUTE_SEQUENCE      ,//= 44, CMD_JTAG_EXECUTE_SEQUENCE
-   };
-static const FunctionPtrs JTAGFunctionPointers   = {CMD_USBDM_CONNECT,
-                                                    sizeof(JTAGfunctionPtrs)/sizeof(FunctionPtr),     
-                                                    JTAGfunctionPtrs};
-#endif 
-
-#if (TARGET_CAPABILITY&CAP_ARM_SWD)
-static const FunctionPtr SWDfunctionPtrs[] = {
-   // Target specific versions
-   // Target specific versions
-   f_CMD_SWD_CONNECT                ,//= 15, CMD_USBDM_CONNECT
-   f_CMD_SPI_SET_SPEED              ,//= 16, CMD_USBDM_SET_SPEED
-   f_CMD_SPI_GET_SPEED              ,//= 17, CMD_USBDM_GET_SPEED
-   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
-   f_CMD_ILLEGAL                    ,//= 19, RESERVED
-   f_CMD_ILLEGAL                    ,//= 20, CMD_USBDM_READ_STATUS_REG
-   f_CMD_ILLEGAL                    ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
-   f_CMD_ILLEGAL                    ,//= 22, CMD_USBDM_TARGET_RESET
-   f_CMD_SWD_TARGET_STEP            ,//= 23, CMD_USBDM_TARGET_STEP
-   f_CMD_SWD_TARGET_GO              ,//= 24, CMD_USBDM_TARGET_GO
-   f_CMD_SWD_TARGET_HALT            ,//= 25, CMD_USBDM_TARGET_HALT
-   f_CMD_SWD_WRITE_REG              ,//= 26, CMD_USBDM_WRITE_REG
-   f_CMD_SWD_READ_REG               ,//= 27  CMD_USBDM_READ_REG
-   f_CMD_SWD_WRITE_CREG             ,//= 28  CMD_USBDM_WRITE_CREG
-   f_CMD_SWD_READ_CREG              ,//= 29  CMD_USBDM_READ_CREG
-   f_CMD_SWD_WRITE_DREG             ,//= 30  CMD_USBDM_WRITE_DREG
-   f_CMD_SWD_READ_DREG              ,//= 31  CMD_USBDM_READ_DREG
-   f_CMD_SWD_WRITE_MEM              ,//= 32  CMD_USBDM_WRITE_MEM
-   f_CMD_SWD_READ_MEM               ,//= 33  CMD_USBDM_READ_MEM
-   };
-static const FunctionPtrs SWDFunctionPointers   = {CMD_USBDM_CONNECT,
-                                                    sizeof(SWDfunctionPtrs)/sizeof(FunctionPtr),     
-                                                    SWDfunctionPtrs};
-#endif 
-
-//! Ptr to function table for current target type
-static const FunctionPtrs *currentFunctions = NULL; // default to empty
-
-//! Set target type
-//! Initialise interface for given target
-//! @note
-//!   commandBuffer        \n
-//!   - [2] = target type
-//!
-U8 f_CMD_SET_TARGET(void) {
-U8 target = commandBuffer[2];
-
-   switch (target) {
-#if (TARGET_CAPABILITY&CAP_HCS12)
-   case T_HC12:
-         currentFunctions = &HCS12FunctionPointers;
-         break;
-#endif
-#if (TARGET_CAPABILITY&CAP_HCS08)
-      case T_HCS08:
-         currentFunctions = &HCS08FunctionPointers;
-         break;
-#endif
-#if (TARGET_CAPABILITY & CAP_RS08)
-      case T_RS08:
-          currentFunctions = &HCS08FunctionPointers;
-          break;
-#endif
-#if (TARGET_CAPABILITY & CAP_CFV1)
-      case T_CFV1:
-         currentFunctions = &CFV1FunctionPointers;
-         break;
-#endif         
-#if (TARGET_CAPABILITY&CAP_CFVx)
-      case T_CFVx:
-         currentFunctions = &CFVxFunctionPointers;
-         break;
-#endif
-#if (TARGET_CAPABILITY&CAP_JTAG)
-      case T_JTAG:
-         currentFunctions = &JTAGFunctionPointers;
-         break;
-#endif
-#if (TARGET_CAPABILITY&CAP_DSC)
-      case T_MC56F80xx:
-         currentFunctions = &JTAGFunctionPointers;
-         break;
-#endif
-#if (TARGET_CAPABILITY&CAP_ARM_JTAG)
-      case T_ARM_JTAG:
-         currentFunctions = &JTAGFunctionPointers;
-         break;
-#endif
-#if (TARGET_CAPABILITY&CAP_ARM_SWD)
-      case T_ARM_SWD:
-         currentFunctions = &SWDFunctionPointers;
-         break;
-#endif
-      case T_OFF:
-         currentFunctions = NULL;
-         break;
-         
-      default:
-         currentFunctions = NULL;
-         (void)bdm_setTarget(T_OFF);
-         return BDM_RC_UNKNOWN_TARGET; 
-   }
-   return bdm_setTarget(target);
-}
-
-//!  Processes all commands received over USB
-//!
-//!  The command is expected to be in \ref commandBuffer[1..N]
-//!
-//!  @return Number of bytes left in commandBuffer to be sent back as response.\n
-//!         commandBuffer[0]    = result code, BDM_RC_OK => success, else failure error code\n
-//!         commandBuffer[1..N] = command results
-//!
-U8 commandExec(void) {
-BDMCommands command    = commandBuffer[1];  // Command is 1st byte
-FunctionPtr commandPtr = f_CMD_ILLEGAL;     // Default to illegal command
-
-#if (DEBUG&COMMAND_BUSY)
-   DEBUG_PIN_DDR = 1;
-   DEBUG_PIN     = 1;
-#endif
-
-   // Check if modeless command
-   if ((U8)command < sizeof(commonFunctionPtrs)/sizeof(FunctionPtr)) {
-      // Modeless command
-      commandPtr = commonFunctionPtrs[(U8)command];
-   }
-   else {
-      // Target specific command
-      if (currentFunctions != NULL) {
-         int commandIndex = (U8)command - currentFunctions->firstCommand;
-         if ((commandIndex >= 0) && (commandIndex < currentFunctions->size))
-            commandPtr = currentFunctions->functions[commandIndex];
-      }
-   }
-   // Execute the command
-   // Note: returnSize & commandBuffer may be updated by command
-   //       returnSize has a default value of 1
-   //       commandStatus has a default value of BDM_RC_OK
-   //       On error, returnSize is forced to 1
-   returnSize       = 1;
-   commandStatus = BDM_RC_OK;
-   if (command >= CMD_USBDM_READ_STATUS_REG) {
-      // Check if re-connect needed before most commands (always)
-      commandStatus = optionalReconnect(AUTOCONNECT_ALWAYS);
-   }
-   if (commandStatus == BDM_RC_OK) {
-      commandStatus = commandPtr();      // Execute command & update command status
-      commandBuffer[0] = commandStatus;  // return command status
-   }
-   if (commandStatus != BDM_RC_OK) {
-      returnSize = 1;  // Return a single byte error code
-      // Do any common cleanup here
-#if (TARGET_CAPABILITY&CAP_ARM_SWD)
-   if (cable_status.target_type == T_ARM_SWD) {
-      // Clear stick bits since already reporting error
-	   (void)swd_clearStickyError();
-   }
-#endif
-#if (TARGET_CAPABILITY&CAP_CFVx)
-      if (cable_status.target_type == T_CFVx) {
-         (void)bdmcf_complete_chk_rx(); //  Send at least 2 NOPs to purge the BDM
-         (void)bdmcf_complete_chk_rx(); //  of the offending command
-      }
-#endif
-   }
-#if (DEBUG&COMMAND_BUSY)
-   DEBUG_PIN_DDR = 1;
-   DEBUG_PIN     = 0;
-#endif
-   return returnSize;
-}
-
-#if (VERSION_HW!=(HW_JB+TARGET_HARDWARE))
-void commandLoop(void) {
-U8 size;
-// Define to discard commands at random for command retry testing
-//#define TESTDISCARD
-
-   static U8 commandToggle = 0;
-#ifdef TESTDISCARD
-   static U8 doneErrorFlag = FALSE;
-   RTCSC = (2<<RTCSC_RTCLKS_BITNUM)|(8<<RTCSC_RTCPS_BITNUM);
-   RTCMOD = 0xFF;
-#endif
-   
-#if 1
-   for(;;) {
-      (void)receiveUSBCommand( MAX_COMMAND_SIZE, commandBuffer );
-#ifdef TESTDISCARD
-      if (RTCCNT == 128) {
-    	  if (!doneErrorFlag) {
-    	     doneErrorFlag = TRUE;
-    	     continue;
-    	  }
-      }
-      else
-    	  doneErrorFlag = FALSE;
-#endif
-      commandToggle = commandBuffer[1] & 0x80;
-      commandBuffer[1] &= 0x7F;
-      size = commandExec();
-      commandBuffer[0] |= commandToggle;
-	  sendUSBResponse( size, commandBuffer );
-   }
-#elif 0
-   for(;;) {
-      enableInterrupts();
-      (void)receiveUSBCommand( MAX_COMMAND_SIZE, commandBuffer );
-      if (commandBuffer[1] == CMD_USBDM_GET_CAPABILITIES)
-    	  commandToggle = 0;
-      commandBuffer[1] &= 0x7F;
-      size = commandExec();
-      if (commandToggle)
-    	 commandBuffer[0] |= 0x80;
-      else
-     	 commandBuffer[0] &= ~0x80;
-      commandToggle += 0x80;
-      sendUSBResponse( size, commandBuffer );
-   }
-#else
-   for(;;) {
-      enableInterrupts();
-      (void)receiveUSBCommand( MAX_COMMAND_SIZE, commandBuffer );
-      size = commandExec();
-      sendUSBResponse( size, commandBuffer );
-   }
-#endif
-}
-#endif
+/*! \file
+    \brief USBDM - Main command procedure for executing BDM commands.
+
+   This file processes the commands received over the USB link from the host
+
+   \verbatim
+   This software was modified from \e TBLCF software
+   This software was modified from \e TBDML software
+
+   USBDM
+   Copyright (C) 2007  Peter O'Donoghue
+
+   Turbo BDM Light
+   Copyright (C) 2005  Daniel Malik
+
+   Turbo BDM Light ColdFire
+   Copyright (C) 2005  Daniel Malik
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+   \endverbatim
+
+   \verbatim
+   Change History
+   +===============================================================================================
+   | 17 Oct 2026 | Added read cache for halted target (CMD_USBDM_SET_READ_CACHE)           V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_WRITE_MEM_RLE                                            V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_READ_MEM_RLE                                             V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_HASH_MEM                                                 V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_MODIFY_MEM                                               V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_POLL_MEM                                                 V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_READ_MEM_GATHER                                          V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_VERIFY_MEM                                               V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_FILL_MEM                                                 V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_CRC_MEM                                                  V4.10
+   | 17 Oct 2026 | optionalReconnect() trusts measured speed for CONNECTION_VALIDms        V4.10
+   | 17 Oct 2026 | Added command trace (DEBUG&COMMAND_TRACE)                                V4.10
+   | 17 Oct 2026 | Added per-command execution time statistics (DEBUG&COMMAND_TIMING)      V4.10
+   | 17 Oct 2026 | Added command progress & abort (CMD_USBDM_GET_PROGRESS/ABORT on ep0)     V4.10
+   | 17 Oct 2026 | Added commandIdle() - BDM target halt for target event notification       V4.10
+   | 17 Oct 2026 | Added peekStatusWord() for target event notification                     V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_EXECUTE_BATCH                                            V4.10
+   | 17 Oct 2026 | Added CMD_USBDM_READ_MEM_STREAM & extended command table                 V4.10
+   | 20 May 2012 | Extended firmware version information                                    V4.9.5
+   |  8 Apr 2012 | Fixed missing PST status in makeStatusWord()                       - pgo V4.7.4
+   | 20 Apr 2011 | Added DE to f_CMD_USBDM_CONTROL_PINS                               - pgo V4.7
+   | 20 Apr 2011 | Added CMD_USBDM_SET_VDD                                            - pgo V4.6
+   | 20 Apr 2011 | Added CMD_USBDM_CONTROL_PINS                                       - pgo V4.6
+   | 31 Mar 2011 | Added command toggle                                               - pgo V4.6
+   | 24 Feb 2011 | Extended auto-connect options                                      - pgo V4.6
+   | 26 Nov 2010 | Modified f_CMD_SET_OPTIONS so changes do NOT have immediate effect - pgo V4.3
+   |  8 Aug 2010 | Added supported target check                                       - pgo 
+   |  8 Aug 2010 | Re-arranged target execution tables & added DSC                    - pgo 
+   | 21 Jun 2010 | Added T_MC56F800xx Type                                            - pgo
+   | 20 May 2010 | Added JTAG as separate command table                               - pgo
+   | 10 May 2010 | Many changes in Vpp/RS08 code (deleted!)                           - pgo
+   |  1 May 2010 | Action option changes immediately in f_CMD_SET_OPTIONS()           - pgo
+   |    Oct 2009 | Extended status information available                              - pgo
+   |    Sep 2009 | Major changes for V2                                               - pgo
+   -=======================================================================================
+   |  3 Feb 2009 | Extended bdm_setInterfaceLeve[]                                    - pgo
+   | 20 Jan 2009 | Merged HCS/CFV1 code from USBDM                                    - pgo
+   | 13 Jan 2009 | Moved CFVx commands to separate file                               - pgo
+   | 12 Jan 2009 | Changed to dispatch table & individual functions                   - pgo
+   |  1 Jan 2009 | Ported to JMxx from JB16 TBLCF code                                - pgo
+   +=======================================================================================
+   \endverbatim
+*/
+#include <string.h>
+#include "Common.h"
+#include "Configure.h"
+#include "Commands.h"
+#include "BDMCommon.h"
+#include "BDM_CF.h"
+#include "BDM_RS08.h"
+#include "BDM.h"
+#include "SWD.h"
+#include "USB.h"
+#include "ICP.h"
+#include "CmdProcessing.h"
+#include "CmdProcessingHCS.h"
+#include "CmdProcessingCFVx.h"
+#include "CmdProcessingCFV1.h"
+#include "CmdProcessingSWD.h"
+#include "TargetDefines.h"
+
+#ifdef __HC08__
+#pragma DATA_SEG __SHORT_SEG Z_PAGE
+#endif // __HC08__
+//! Status of the BDM
+//!
+//! see \ref CableStatus_t
+CableStatus_t cable_status = { T_OFF };
+
+//! Options for the BDM
+//!
+//! see \ref BDM_Option_t
+BDM_Option_t bdm_option = {
+   BDM_TARGET_VDD_OFF,  //!< Target Vdd (off, 3.3V or 5V)
+   FALSE,               //!< Cycle target Power when resetting
+   FALSE,               //!< Cycle target Power if connection problems (when resetting?)
+   FALSE,               //!< Leave target power on when exiting
+   AUTOCONNECT_STATUS,  //!< Automatically re-connect to target (for speed change)
+   TRUE,                //!< Guess speed for target w/o ACKN
+   CS_DEFAULT,          //!< Use alternative BDM clock source in target
+   FALSE,               //!< Use RESET signal on BDM interface
+   {0}                  //   Reserved
+};
+#pragma DATA_SEG DEFAULT
+
+//! Buffer for Rx and Tx of commands & results
+U8  commandBuffer[MAX_COMMAND_SIZE];
+
+#ifdef __HC08__
+#pragma DATA_SEG __SHORT_SEG Z_PAGE
+#endif // __HC08__
+static U8  commandStatus;      //!< Error code from last/current command
+static U8  commandToggle;      //!< Toggle bit from current command (returned in response)
+U8  returnSize;                //!< Size of command result
+#pragma DATA_SEG DEFAULT
+
+static U8  connectionValid;    //!< Speed measured by optionalReconnect() may be trusted
+static U16 connectionTime;     //!< usbFrameCount when speed was measured
+//! Target reset seen by statusWord() (may be called from ISR) - handled by commandExec()
+static volatile U8 targetResetSeen;
+
+//! Progress of current command - Polled on ep0 by CMD_USBDM_GET_PROGRESS
+volatile CommandProgress_t commandProgress;
+//! Set on ep0 by CMD_USBDM_ABORT - Long operations poll this and stop with BDM_RC_ABORTED
+volatile U8                commandAbort;
+
+//! Set number of bytes completed by the current command
+//!
+//! @param done - # of bytes completed
+//!
+//! @note commandProgress.done is read by the USB interrupt (CMD_USBDM_GET_PROGRESS) so it
+//!       is written with interrupts masked - a partly written value is never reported
+//!
+void setCommandProgress(U32 done) {
+U8 interruptMask = saveAndDisableInterrupts();
+
+   commandProgress.done = done;
+   setInterrupts(interruptMask);
+}
+
+#if (HW_CAPABILITY&CAP_BDM)
+#define HALT_POLLms (10U)      //!< Interval between halt checks while waiting for a command (ms)
+static volatile U8 idleHalted; //!< BDM target halted when last checked by commandIdle()
+static U16 idleHaltTime;       //!< usbFrameCount when halt was last checked
+#endif
+
+#if (CPU==JMxx)
+#define READ_CACHE (1) //!< Cache target reads while halted
+#else
+#define READ_CACHE (0) //!< Insufficient RAM for read cache
+#endif
+
+//==========================================================================
+// Modeless commands
+//==========================================================================
+
+//! Creates status byte
+//!
+//! @param clearEvents - clear latched events (reset detected) once reported
+//!
+//! @return 16-bit status byte \ref StatusBitMasks_t
+//!
+static U16 statusWord(U8 clearEvents) {
+U16 status = 0;
+
+   // Target specific checks
+   switch (cable_status.target_type) {
+#if (HW_CAPABILITY&CAP_CFVx_HW) && (TARGET_CAPABILITY&CAP_PST)
+   case T_CFVx : 
+	  if (ALLPST_IS_HIGH) {
+         status |= S_HALT;  // Target is halted
+	  }
+      break;
+#endif
+#if HW_CAPABILITY&CAP_BDM	   
+   case T_HC12:
+   case T_HCS08:
+   case T_RS08:
+   case T_CFV1:
+	  if (cable_status.ackn==ACKN) {  // Target supports ACKN and the feature is enabled ?
+		 status |= S_ACKN;
+	  }
+      switch (cable_status.speed) {
+//      case SPEED_NO_INFO       : status |= S_NOT_CONNECTED;  break; 
+        case SPEED_USER_SUPPLIED : status |= S_USER_DONE;      break; 
+        case SPEED_SYNC          : status |= S_SYNC_DONE;      break; 
+        case SPEED_GUESSED       : status |= S_GUESS_DONE;     break; 
+        default                  :                             break;
+      }
+	  break;
+#endif	  
+   default:
+      break;
+   }
+#if (HW_CAPABILITY&CAP_RST_IO)
+   if (RESET_IS_HIGH) {
+      status |= S_RESET_STATE;   // The RSTO pin is currently high
+   }
+   if (cable_status.reset==RESET_DETECTED) {
+      status |= S_RESET_DETECT;                    // The target was recently reset externally
+      targetResetSeen = TRUE;                      // Target speed may have changed & is no longer halted
+      if (clearEvents && RESET_IS_HIGH) {
+         cable_status.reset = NO_RESET_ACTIVITY;   // Clear the flag if reset pin has returned high
+      }
+   }
+#endif
+#if (HW_CAPABILITY&CAP_VDDSENSE)
+   switch (cable_status.power) {    // Target has power ?
+//    case BDM_TARGET_VDD_NONE : status |= S_POWER_NONE; break;
+      case BDM_TARGET_VDD_ERR  : status |= S_POWER_ERR;  break;
+      case BDM_TARGET_VDD_INT  : status |= S_POWER_INT;  break;
+      case BDM_TARGET_VDD_EXT  : status |= S_POWER_EXT;  break;
+      default                  :                         break;
+   }
+#else
+   // Assume power present
+   status |= S_POWER_EXT;
+#endif
+#if (HW_CAPABILITY&CAP_FLASH)
+   switch (cable_status.flashState) {
+//    case BDM_TARGET_VPP_OFF     : status |= S_VPP_OFF;      break;
+      case BDM_TARGET_VPP_STANDBY : status |= S_VPP_STANDBY;  break;
+      case BDM_TARGET_VPP_ON      : status |= S_VPP_ON;       break;
+      case BDM_TARGET_VPP_ERROR   : status |= S_VPP_ERR;      break;
+      default                     :                           break;
+   }
+#endif
+   return status;
+}
+
+//! Creates status byte
+//!
+//! @return 16-bit status byte \ref StatusBitMasks_t
+//!
+//! @note Clears the reset detected status once reported
+//!
+U16 makeStatusWord(void) {
+   return statusWord(TRUE);
+}
+
+//! Creates status byte without affecting latched events
+//! Used for target event notification
+//!
+//! @return 16-bit status byte \ref StatusBitMasks_t
+//!
+U16 peekStatusWord(void) {
+U16 status = statusWord(FALSE);
+
+#if (HW_CAPABILITY&CAP_BDM)
+   if (idleHalted) {
+      status |= S_HALT;  // Halt of BDM target as found by commandIdle()
+   }
+#endif
+   return status;
+}
+
+//! Checks if a BDM target has halted - called while waiting for a command
+//!
+//! Reading the BDM status is not safe from the USB interrupt that reports
+//! target events (it may interrupt a BDM transfer) so it is polled here,
+//! between commands, and reported through peekStatusWord().
+//!
+//! @note May leave interrupts disabled (BDM transfer)
+//!
+void commandIdle(void) {
+#if (HW_CAPABILITY&CAP_BDM)
+U8 bdmStatus;
+U8 haltMask;
+
+   if ((U16)(usbFrameCount-idleHaltTime) < HALT_POLLms) {
+      return;
+   }
+   idleHaltTime = usbFrameCount;
+   switch (cable_status.target_type) {
+      case T_HC12:  haltMask = HC12_BDMSTS_BDMACT; break;
+      case T_HCS08: haltMask = HC08_BDCSCR_BDMACT; break;
+      case T_RS08:  haltMask = RS08_BDCSCR_BDMACT; break;
+      case T_CFV1:  haltMask = CFV1_XCSR_HALT;     break;
+      default:      haltMask = 0;                  break;
+   }
+   if ((haltMask == 0) || (cable_status.speed == SPEED_NO_INFO) ||
+       (bdm_readBDMStatus(&bdmStatus) != BDM_RC_OK)) {
+      idleHalted = FALSE;  // Not known
+      return;
+   }
+   idleHalted = ((bdmStatus&haltMask) != 0);
+#endif
+}
+
+//! Optionally re-connects with target
+//!
+//! @param when indicates situation in which the routine is being called\n
+//!       AUTOCONNECT_STATUS  - being called during status query
+//!	      AUTOCONNECT_ALWAYS, - being called before command execution
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success       \n
+//!    != \ref BDM_RC_OK => error 
+//! 
+U8 optionalReconnect(U8 when) {
+U8 rc = BDM_RC_OK;
+   (void)when; // remove warning
+#if HW_CAPABILITY&CAP_BDM	 
+   switch (cable_status.target_type) {
+   case T_HC12:
+	  if (cable_status.speed == SPEED_USER_SUPPLIED) //   User has specified speed
+         break;
+	  // Fall through
+   case T_RS08:
+   case T_HCS08:
+   case T_CFV1:
+	   if (bdm_option.autoReconnect != when) // Auto re-connect not enabled at this time
+		  break;
+	   if ((when == AUTOCONNECT_ALWAYS) && connectionValid &&
+	       (cable_status.speed != SPEED_NO_INFO) &&
+	       (cable_status.reset != RESET_DETECTED) &&
+	       ((U16)(usbFrameCount-connectionTime) < CONNECTION_VALIDms)) {
+		  // Speed measured recently & nothing has happened to change it
+		  break;
+	   }
+	   rc = bdm_physicalConnect();           // Make sure of connection
+	   connectionValid = (rc == BDM_RC_OK);
+	   connectionTime  = usbFrameCount;
+	   break;
+   default: ;
+   }
+#endif
+   return rc;
+}
+
+//! Dummy routine for unused slots in command table
+//!
+//! @return
+//!    BDM_RC_ILLEGAL_COMMAND => illegal command
+//!
+U8 f_CMD_ILLEGAL(void) {
+   return BDM_RC_ILLEGAL_COMMAND;
+}
+
+//! Return status from last command received
+//!
+//! @return
+//!   status from last command
+//!
+U8 f_CMD_GET_COMMAND_STATUS(void) {
+   return commandStatus;
+}
+
+#if (DEBUG&COMMAND_TIMING)
+//==========================================================================
+// Command execution time statistics
+//
+// Times are measured in TPM ticks (TIMER_FREQ).  The TPM counter wraps every
+// few ms so longer commands are timed using the USB frame count (~1 ms).
+//
+// Statistics are only kept for the first COMMAND_TIMING_SLOTS different command
+// codes seen (a session uses few) - later command codes are not timed.
+//
+#define COMMAND_TIMING_SLOTS   (16) //!< Number of different command codes timed
+#define COMMAND_TIMING_BUCKETS (16) //!< Histogram buckets, bucket n < 2^(COMMAND_TIMING_BUCKET0+n) ticks
+#define COMMAND_TIMING_BUCKET0 (10) //!< log2 of upper limit of bucket 0 (~43 us at 24 MHz)
+#define COMMAND_TIMING_SIZE    (2+3*4+2*COMMAND_TIMING_BUCKETS) //!< Size of statistics in response
+
+//! Execution time statistics for a single command code
+typedef struct {
+   U8  command;                              //!< Command code
+   U16 count;                                //!< Number of times executed, 0 => slot unused
+   U32 minTicks;                             //!< Shortest execution time
+   U32 maxTicks;                             //!< Longest execution time
+   U32 totalTicks;                           //!< Total execution time
+   U16 histogram[COMMAND_TIMING_BUCKETS];    //!< Count of times in each bucket
+} CommandTiming_t;
+
+static CommandTiming_t commandTiming[COMMAND_TIMING_SLOTS];
+
+//! Clear execution time statistics
+//!
+static void clearCommandTiming(void) {
+   (void)memset(commandTiming, 0, sizeof(commandTiming));
+}
+
+//! Returns elapsed time since given start
+//!
+//! @param startTicks - TPMCNT value at start
+//! @param startFrame - usbFrameCount value at start
+//!
+//! @return elapsed time in timer ticks
+//!
+static U32 elapsedTicks(U16 startTicks, U16 startFrame) {
+U16 ticks  = TPMCNT - startTicks;
+U16 frames = usbFrameCount - startFrame;
+
+   if (frames < 2) {
+      // TPM counter can't have wrapped
+      return ticks;
+   }
+   return (U32)frames * (TIMER_FREQ/1000);
+}
+
+//! Find statistics for command
+//!
+//! @param command  - command code
+//! @param allocate - use a free slot if the command has not been seen
+//!
+//! @return statistics, NULL => command not seen & no free slot (or not allocating)
+//!
+static CommandTiming_t *findCommandTiming(U8 command, U8 allocate) {
+U8 index;
+
+   for (index=0; index<COMMAND_TIMING_SLOTS; index++) {
+      if (commandTiming[index].count == 0) {
+         // Slots are used in order - 1st unused slot ends search
+         if (!allocate) {
+            return NULL;
+         }
+         commandTiming[index].command = command;
+         return &commandTiming[index];
+      }
+      if (commandTiming[index].command == command) {
+         return &commandTiming[index];
+      }
+   }
+   return NULL;
+}
+
+//! Add execution time to statistics for command
+//!
+//! @param command - command code
+//! @param ticks   - execution time in timer ticks
+//!
+static void recordCommandTiming(U8 command, U32 ticks) {
+CommandTiming_t *timing = findCommandTiming(command, TRUE);
+U8  bucket = 0;
+U32 scaled = ticks>>COMMAND_TIMING_BUCKET0;
+
+   if ((timing == NULL) || (timing->count == 0xFFFF)) {
+      // Table full or saturated
+      return;
+   }
+   while ((scaled != 0) && (bucket < COMMAND_TIMING_BUCKETS-1)) {
+      scaled >>= 1;
+      bucket++;
+   }
+   timing->count++;
+   timing->totalTicks += ticks;
+   timing->histogram[bucket]++;
+   if ((timing->count == 1) || (ticks < timing->minTicks)) {
+      timing->minTicks = ticks;
+   }
+   if (ticks > timing->maxTicks) {
+      timing->maxTicks = ticks;
+   }
+}
+
+//! Write a value to the response in big-endian order
+//!
+//! @param offset - offset in commandBuffer
+//! @param value  - value to write
+//! @param size   - # of bytes (2 or 4)
+//!
+//! @return offset following value
+//!
+static U8 putTimingValue(U8 offset, U32 value, U8 size) {
+U8 index = size;
+
+   while (index-- > 0) {
+      commandBuffer[offset+index] = (U8)value;
+      value >>= 8;
+   }
+   return offset+size;
+}
+
+//! Copy execution time statistics for command to commandBuffer
+//!
+//! @param command - command code
+//!
+//! @return
+//!    error code
+//!
+//! @note A command that has not been timed returns all zeroes
+//!
+static U8 readCommandTiming(U8 command) {
+CommandTiming_t *timing = findCommandTiming(command, FALSE);
+U8  offset = 1;
+U8  index;
+
+   if (timing == NULL) {
+      // Not seen - report as never executed
+      (void)memset(commandBuffer+1, 0, COMMAND_TIMING_SIZE);
+      returnSize = 1+COMMAND_TIMING_SIZE;
+      return BDM_RC_OK;
+   }
+   offset = putTimingValue(offset, timing->count,      2);
+   offset = putTimingValue(offset, timing->minTicks,   4);
+   offset = putTimingValue(offset, timing->maxTicks,   4);
+   offset = putTimingValue(offset, timing->totalTicks, 4);
+   for (index=0; index<COMMAND_TIMING_BUCKETS; index++) {
+      offset = putTimingValue(offset, timing->histogram[index], 2);
+   }
+   returnSize = offset;
+   return BDM_RC_OK;
+}
+#endif // (DEBUG&COMMAND_TIMING)
+
+#if (DEBUG&COMMAND_TRACE)
+//==========================================================================
+// Command trace
+//
+// A record of each command is written to a ring buffer by commandLoop().
+// When full the oldest records are discarded.
+//
+#define COMMAND_TRACE_SIZE (32)  //!< Number of records in ring buffer (power of 2)
+
+//! Command trace record (returned by \ref BDM_DBG_TRACE)
+typedef struct {
+   U8  command;        //!< Command byte as received (including toggle bit)
+   U8  commandSize;    //!< Size of command
+   U8  status;         //!< Status byte returned
+   U8  responseSize;   //!< Size of response (0 => streamed)
+   U16 frameCount;     //!< USB frame count (~1 ms) when command was received
+   U16 timerTicks;     //!< Timer (TPM) count when command was received
+} CommandTraceRecord_t;
+
+static CommandTraceRecord_t commandTrace[COMMAND_TRACE_SIZE];
+static U8 traceHead;             //!< Index of next record to write
+static U8 traceCount;            //!< Number of records in buffer
+static U8 traceLost;             //!< Number of records discarded (saturates)
+
+//! Add record to trace buffer
+//!
+//! @param record - record to add
+//!
+static void addCommandTrace(const CommandTraceRecord_t *record) {
+   commandTrace[traceHead] = *record;
+   traceHead = (traceHead+1)&(COMMAND_TRACE_SIZE-1);
+   if (traceCount < COMMAND_TRACE_SIZE) {
+      traceCount++;
+   }
+   else if (traceLost < 0xFF) {
+      traceLost++;
+   }
+}
+
+//! Copy oldest trace records to commandBuffer & remove them from the trace
+//!
+//! @return
+//!    error code
+//!
+static U8 readCommandTrace(void) {
+U8 numRecords = (MAX_COMMAND_SIZE-3)/sizeof(CommandTraceRecord_t);
+U8 tail       = (traceHead-traceCount)&(COMMAND_TRACE_SIZE-1);
+U8 *ptr       = commandBuffer+3;
+U8 index;
+
+   if (numRecords > traceCount) {
+      numRecords = traceCount;
+   }
+   commandBuffer[1] = numRecords;
+   commandBuffer[2] = traceLost;
+   for (index=0; index<numRecords; index++) {
+      (void)memcpy(ptr, &commandTrace[tail], sizeof(CommandTraceRecord_t));
+      ptr  += sizeof(CommandTraceRecord_t);
+      tail  = (tail+1)&(COMMAND_TRACE_SIZE-1);
+   }
+   traceCount -= numRecords;
+   traceLost   = 0;
+   returnSize  = 3+numRecords*sizeof(CommandTraceRecord_t);
+   return BDM_RC_OK;
+}
+#endif // (DEBUG&COMMAND_TRACE)
+
+//! Various debugging & testing commands
+//!
+//! @note
+//!   commandBuffer           \n
+//!    - [1..N] = various commands
+//!
+//! @return
+//!    error code
+//!
+U8 f_CMD_DEBUG(void) {
+
+DebugSubCommands subCommand = commandBuffer[2];
+
+   switch ((U8)subCommand) {
+#if (HW_CAPABILITY&CAP_BDM)     
+      case BDM_DBG_ACKN: // try the ACKN feature
+         bdm_acknInit();
+         commandBuffer[1] = (U8) makeStatusWord(); // return the status byte
+         returnSize = 2;
+         return BDM_RC_OK;
+
+      case BDM_DBG_SYNC: { // try the sync feature
+         U8 rc;
+         rc = bdm_syncMeasure();
+         if (rc != BDM_RC_OK)
+            return rc;
+         commandBuffer[1] = (U8)makeStatusWord(); // return the status byte
+         (*(U16*)(commandBuffer+2)) = cable_status.sync_length;
+         returnSize = 4;
+         }
+         return BDM_RC_OK;
+
+      case BDM_DBG_TESTPORT: // Check port I/O timing - hangs USB interface
+         bdm_checkTiming();
+         return BDM_RC_OK;
+#endif
+#if (HW_CAPABILITY & CAP_FLASH)
+      case BDM_DBG_VPP_OFF: // Programming voltage off
+         return bdmSetVpp(BDM_TARGET_VPP_OFF );
+
+      case BDM_DBG_VPP_ON:
+         // Programming voltage on (requires FLASH12V on first)
+         return bdmSetVpp(BDM_TARGET_VPP_ON );
+
+      case BDM_DBG_FLASH12V_OFF: // 12V charge pump off
+         return bdmSetVpp(BDM_TARGET_VPP_OFF );
+
+      case BDM_DBG_FLASH12V_ON:  // 12V charge pump on
+         return bdmSetVpp(BDM_TARGET_VPP_STANDBY );
+#endif
+#if (HW_CAPABILITY & CAP_VDDCONTROL)
+      case BDM_DBG_VDD_OFF: // Target Vdd voltage off
+         VDD_OFF();
+         return BDM_RC_OK;
+
+      case BDM_DBG_VDD3_ON: // Target Vdd voltage on
+         VDD3_ON();
+         return BDM_RC_OK;
+
+      case BDM_DBG_VDD5_ON: // Target Vdd voltage on
+         VDD5_ON();
+         return BDM_RC_OK;
+
+      case BDM_DBG_CYCLE_POWER: // Cycle power to target
+         return bdm_cycleTargetVdd(RESET_SPECIAL);
+#endif
+#if (HW_CAPABILITY & CAP_VDDSENSE)
+      case BDM_DBG_MEASURE_VDD: // Measure Target Vdd
+         (*(U16*)(commandBuffer+1)) = bdm_targetVddMeasure(); // return the value
+         returnSize = 3;
+         return BDM_RC_OK;
+#endif
+#if defined(INLINE_ACKN)
+      case BDM_DBG_TESTWAITS:
+         bdm_checkWaitTiming();
+         return BDM_RC_OK;
+#endif
+
+      case BDM_DBG_TESTALTSPEED:
+         return BDM_RC_OK;
+
+#if (DEBUG&STACK_DEBUG)
+      case BDM_DBG_STACKSIZE: // Measure stack size
+         {
+         extern char  __SEG_START_SSTACK[];     // Bottom of stack space
+         extern char  __SEG_END_SSTACK[];       // Top of stack space
+         char *stackProbe = __SEG_START_SSTACK; // Probe for stack RAM
+
+         while (*++stackProbe == 0) { // Find 1st used (non-zero) byte on stack
+         }
+         (*(U16*)(commandBuffer+1)) = (U16)(__SEG_END_SSTACK - stackProbe);
+         returnSize = 3;
+         return BDM_RC_OK;
+         }
+#endif // (DEBUG&STACK_DEBUG)
+#if (HW_CAPABILITY&CAP_BDM)     
+      case BDM_DBG_TESTBDMTX: // Test BDM Tx routine
+         return bdm_testTx(commandBuffer[3]);
+#endif
+#if HW_CAPABILITY & CAP_SWD_HW
+      case   BDM_DBG_SWD: //!< - Test SWD functions
+    	 return swd_test();
+#endif
+#if (DEBUG&COMMAND_TIMING)
+      case BDM_DBG_TIMING: // Get execution time statistics for a command
+         return readCommandTiming(commandBuffer[3]);
+
+      case BDM_DBG_TIMING_RESET: // Clear execution time statistics
+         clearCommandTiming();
+         return BDM_RC_OK;
+#endif
+#if (DEBUG&COMMAND_TRACE)
+      case BDM_DBG_TRACE: // Read command trace
+         return readCommandTrace();
+#endif
+   } // switch
+   return BDM_RC_ILLEGAL_PARAMS;
+}
+
+//! Set various options
+//!
+//! @note
+//!   commandBuffer\n
+//!   - [2..N] = options (image of \ref BDM_Option_t)
+//!
+//!  @return
+//!    BDM_RC_OK => success
+//!
+U8 f_CMD_SET_OPTIONS(void) {
+U8 rc = BDM_RC_OK;
+   // Save BDM Options
+   (void)memcpy((U8*)&bdm_option, commandBuffer+2, sizeof(bdm_option));
+   return rc;
+}
+
+//! Returns capability vector for hardware
+//! @return
+//!  commandBuffer                                                \n
+//!   - [1..2] = BDM capability, see \ref HardwareCapabilities_t  \n
+//!   - [3..4] = Maximum command buffer size
+//!
+U8 f_CMD_GET_CAPABILITIES(void) {
+	// Note: CAP_HCS08 & CAP_CFV1 are returned inverted for backwards compatibility
+	// Inversion is hidden by driver!
+   *(U16*)(commandBuffer+1) = TARGET_CAPABILITY^(CAP_HCS08|CAP_CFV1);  // Returns 16-bit value
+   *(U16*)(commandBuffer+3) = MAX_COMMAND_SIZE;
+   commandBuffer[5] = VERSION_MAJOR;             // Extended firmware version number nn.nn.nn
+   commandBuffer[6] = VERSION_MINOR;
+   commandBuffer[7] = VERSION_MICRO;
+   returnSize = 8;
+   return BDM_RC_OK;
+}
+
+//! Return status of BDM communication
+//!
+//! @note
+//!   commandBuffer\n
+//!  - [1..2] = BDM status
+//!
+U8 f_CMD_GET_BDM_STATUS(void) {
+U16 word;
+
+   // Update power status
+   (void)bdm_checkTargetVdd();
+   
+   word = makeStatusWord();
+
+   commandBuffer[1] = (U8) (word>>8);
+   commandBuffer[2] = (U8) word;
+   returnSize  = 3;
+
+   return BDM_RC_OK;
+}
+
+void getPinStatus(void) {
+U16 status;
+
+   status = RESET_IS_LOW?PIN_RESET_LOW:PIN_RESET_HIGH;
+   
+   commandBuffer[1] = (U8) (status>>8);
+   commandBuffer[2] = (U8) status;
+   returnSize  = 3;
+}
+
+//! Directly control pins
+//!
+//! @note
+//!   commandBuffer\n
+//!     Entry: [2..3] = control value\n
+//!     Exit:  [1..2] = pin values (MSB unused) - not yet implemented
+//!
+U8 f_CMD_CONTROL_PINS(void) {
+
+   U16 control = *(U16*)(commandBuffer+2);
+   
+   // Set up for OK return
+   commandBuffer[1] = 0;
+   commandBuffer[2] = 0;
+   returnSize  = 3;
+
+   if (control == PIN_NOCHANGE) {
+	   getPinStatus();
+	   return BDM_RC_OK;
+   }
+   if (control == PIN_RELEASE) {
+	   switch (cable_status.target_type) {
+#if HW_CAPABILITY&CAP_BDM	 	   
+	   case T_HC12 :  
+	   case T_HCS08 :
+	   case T_RS08 :
+	   case T_CFV1 :
+		   bdmHCS_interfaceIdle();
+		   break;
+#endif		   
+#if (HW_CAPABILITY&CAP_CFVx_HW)
+	   case T_CFVx :
+		   bdmcf_interfaceIdle();
+		   break;
+#endif
+#if (HW_CAPABILITY&CAP_JTAG_HW)
+	   case T_JTAG :
+	   case T_ARM_JTAG :
+	   case T_MC56F80xx :
+		   jtag_interfaceIdle();
+		   break;
+#endif
+#if (HW_CAPABILITY&CAP_SWD_HW)
+	   case T_ARM_SWD :
+		   swd_interfaceIdle();
+		   break;
+#endif
+	   case T_OFF :
+	   default:
+		   return BDM_RC_ILLEGAL_COMMAND;
+	   }
+	   getPinStatus();
+	   return BDM_RC_OK;
+   }
+   // Restrict control to mode specific active pins
+   switch (cable_status.target_type) {
+   case T_HC12 :  
+   case T_HCS08 :
+   case T_RS08 :
+   case T_CFV1 :
+	   if (control & ~(PIN_BKGD|PIN_RESET))
+		   return BDM_RC_ILLEGAL_PARAMS;
+	   break;
+#if (HW_CAPABILITY&CAP_CFVx_HW)
+   case T_CFVx :
+	   if (control & ~(PIN_TA|PIN_RESET|PIN_BKPT))
+		   return BDM_RC_ILLEGAL_PARAMS;
+	   break;
+#endif
+#if (HW_CAPABILITY&CAP_JTAG_HW)
+   case T_MC56F80xx :
+	   if (control & ~(PIN_TRST|PIN_RESET|PIN_DE))
+		   return BDM_RC_ILLEGAL_PARAMS;
+	   break;
+   case T_JTAG :
+   case T_ARM_JTAG :
+	   if (control & ~(PIN_TRST|PIN_RESET))
+		   return BDM_RC_ILLEGAL_PARAMS;
+	   break;
+#endif	   
+#if (HW_CAPABILITY&CAP_SWD_HW)
+	   case T_ARM_SWD :
+		   if (control & ~(PIN_SWD|PIN_RESET))
+			   return BDM_RC_ILLEGAL_PARAMS;
+		   break;
+#endif
+   case T_OFF :
+   default:
+	   return BDM_RC_ILLEGAL_PARAMS;
+   }
+
+#if (HW_CAPABILITY & CAP_BDM)
+   switch (control & PIN_BKGD) {
+   case PIN_BKGD_3STATE : 
+	   BDM_3STATE();    // Disable BKGD buffer, BKGD = X
+       break;
+   case PIN_BKGD_LOW :
+	   BDM_LOW();       // Enable BKGD buffer,  BKGD = 0
+       break;
+   case PIN_BKGD_HIGH :
+	   BDM_HIGH();      // Enable BKGD buffer,  BKGD = 1
+       break;
+   }
+#endif
+#if (HW_CAPABILITY & CAP_RST_IO)
+   switch (control & PIN_RESET) {
+   case PIN_RESET_3STATE : 
+	   RESET_3STATE(); 
+	   WAIT_WITH_TIMEOUT_S(2, (RESET_IS_HIGH));
+	   if (RESET_IS_LOW) { 
+          return(BDM_RC_RESET_TIMEOUT_RISE);
+	   }
+	   break;
+   case PIN_RESET_LOW :
+	   RESET_LOW(); 
+	   break;
+   }
+#endif
+   
+#if (HW_CAPABILITY&CAP_JTAG_HW)
+   switch(control&PIN_TRST) {
+   case PIN_TRST_3STATE:
+	   TRST_3STATE();
+	   break;
+   case PIN_TRST_LOW:
+	   TRST_LOW();
+	   break;
+   }
+#endif
+#if (HW_CAPABILITY&CAP_CFVx_HW)
+   switch (control & PIN_TA) {
+   case PIN_TA_3STATE : 
+	   TA_3STATE(); 
+	   break;
+   case PIN_TA_LOW :
+	   TA_LOW(); 
+	   break;
+   }
+
+   switch(control&PIN_BKPT) {
+   case PIN_BKPT_3STATE:
+	   BKPT_HIGH(); // should be 3-state!
+	   break;
+   case PIN_BKPT_LOW:
+	   BKPT_LOW();
+	   break;
+   }
+#endif
+   
+#if (HW_CAPABILITY & CAP_SWD_HW)
+   switch (control & PIN_SWD) {
+   case PIN_SWD_3STATE : 
+	   SWD_3STATE();    // Disable SWD buffer, SWDIO = Z
+       break;
+   case PIN_SWD_LOW :
+	   SWD_LOW();       // Enable SWD buffer,  SWDIO = 0
+       break;
+   case PIN_SWD_HIGH :
+	   SWD_HIGH();      // Enable SWD buffer,  SWDIO = 1
+       break;
+   }
+#endif
+   getPinStatus();
+   return BDM_RC_OK;
+}
+
+//! Directly control Target Vdd
+//!
+//! @note
+//!   commandBuffer\n
+//!     Entry: [2..3] = control value (MSB unused)\n
+//!     Exit:  none
+//!
+U8 f_CMD_SET_VDD(void) {
+   U8 rc;
+#if (HW_CAPABILITY&CAP_VDDCONTROL)
+   bdm_option.targetVdd = commandBuffer[3];
+   rc = bdm_setTargetVdd();
+#else
+   rc = bdm_checkTargetVdd();
+#endif
+   // It's OK if there is no external power at the moment
+   if ((commandBuffer[3] == BDM_TARGET_VDD_OFF) && 
+       (rc == BDM_RC_VDD_NOT_PRESENT))
+	   rc = BDM_RC_OK;
+   return rc;
+}
+
+//=================================================
+// Command Dispatch code
+//=================================================
+//! Ptr to command function
+typedef U8 (*FunctionPtr)(void);
+
+//! Structure representing a set of function ptrs 
+typedef struct {
+   U8 firstCommand;					//!< First command value accepted
+   U8 size;             			//!< Size of command structure
+   const FunctionPtr *functions; 	//!< Ptr to commands
+} FunctionPtrs;
+
+extern U8 f_CMD_SET_TARGET(void);
+extern U8 f_CMD_READ_MEM_STREAM(void);
+extern U8 f_CMD_EXECUTE_BATCH(void);
+extern U8 f_CMD_CRC_MEM(void);
+extern U8 f_CMD_FILL_MEM(void);
+extern U8 f_CMD_VERIFY_MEM(void);
+extern U8 f_CMD_READ_MEM_GATHER(void);
+extern U8 f_CMD_POLL_MEM(void);
+extern U8 f_CMD_MODIFY_MEM(void);
+extern U8 f_CMD_HASH_MEM(void);
+extern U8 f_CMD_READ_MEM_RLE(void);
+extern U8 f_CMD_WRITE_MEM_RLE(void);
+extern U8 f_CMD_SET_READ_CACHE(void);
+
+static const FunctionPtr commonFunctionPtrs[] = {
+   // Common to all targets
+   f_CMD_GET_COMMAND_STATUS         ,//= 0,  CMD_USBDM_GET_COMMAND_STATUS
+   f_CMD_SET_TARGET                 ,//= 1,  CMD_USBDM_SET_TARGET
+   f_CMD_SET_VDD                    ,//= 2,  CMD_USBDM_SET_VDD
+#if (DEBUG&DEBUG_COMMANDS)
+   f_CMD_DEBUG                      ,//= 3,  CMD_USBDM_DEBUG
+#else
+   f_CMD_ILLEGAL                    ,//= 3,  CMD_USBDM_DEBUG - disabled
+#endif
+   f_CMD_GET_BDM_STATUS             ,//= 4,  CMD_USBDM_GET_BDM_STATUS
+   f_CMD_GET_CAPABILITIES           ,//= 5,  CMD_USBDM_GET_CAPABILITIES
+   f_CMD_SET_OPTIONS                ,//= 6,  CMD_USBDM_SET_OPTIONS
+// f_CMD_GET_SETTINGS               ,//= 7,  CMD_USBDM_GET_SETTINGS
+   f_CMD_ILLEGAL                    ,//= 7,  Reserved
+   f_CMD_CONTROL_PINS               ,//= 8,  CMD_USBDM_CONTROL_PINS
+   f_CMD_ILLEGAL                    ,//= 9,  Reserved
+   f_CMD_ILLEGAL                    ,//= 10, Reserved
+   f_CMD_ILLEGAL                    ,//= 11, Reserved
+   f_CMD_ILLEGAL                    ,//= 12, CMD_USBDM_GET_VER (EP0)
+   f_CMD_ILLEGAL                    ,//= 13, Reserved
+   f_CMD_ILLEGAL                    ,//= 14, CMD_USBDM_ICP_BOOT (EP0)
+};
+
+#if (TARGET_CAPABILITY&CAP_HCS12)
+static const FunctionPtr HCS12functionPtrs[] = {
+   // Target specific versions
+   f_CMD_CONNECT                    ,//= 15, CMD_USBDM_CONNECT
+   f_CMD_SET_SPEED                  ,//= 16, CMD_USBDM_SET_SPEED
+   f_CMD_GET_SPEED                  ,//= 17, CMD_USBDM_GET_SPEED
+
+   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
+   f_CMD_ILLEGAL                    ,//= 19, RESERVED
+
+   f_CMD_READ_STATUS_REG            ,//= 20, CMD_USBDM_READ_STATUS_REG
+   f_CMD_WRITE_CONTROL_REG          ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
+
+   f_CMD_RESET                      ,//= 22, CMD_USBDM_TARGET_RESET
+   f_CMD_STEP                       ,//= 23, CMD_USBDM_TARGET_STEP
+   f_CMD_GO                         ,//= 24, CMD_USBDM_TARGET_GO
+   f_CMD_HALT                       ,//= 25, CMD_USBDM_TARGET_HALT
+
+   f_CMD_HCS12_WRITE_REG            ,//= 26, CMD_USBDM_WRITE_REG
+   f_CMD_HCS12_READ_REG             ,//= 27, CMD_USBDM_READ_REG
+
+   f_CMD_ILLEGAL                    ,//= 28, CMD_USBDM_WRITE_CREG
+   f_CMD_ILLEGAL                    ,//= 29, CMD_USBDM_READ_CREG
+
+   f_CMD_WRITE_BD                   ,//= 30, CMD_USBDM_WRITE_DREG
+   f_CMD_READ_BD                    ,//= 31, CMD_USBDM_READ_DREG
+
+   f_CMD_HCS12_WRITE_MEM            ,//= 32, CMD_USBDM_WRITE_MEM
+   f_CMD_HCS12_READ_MEM             ,//= 33, CMD_USBDM_READ_MEM
+   };
+static const FunctionPtrs HCS12FunctionPointers = {CMD_USBDM_CONNECT,
+                                                   sizeof(HCS12functionPtrs)/sizeof(FunctionPtr),
+                                                   HCS12functionPtrs};
+#endif
+
+#if (TARGET_CAPABILITY&(CAP_HCS08|CAP_RS08))
+static const FunctionPtr HCS08functionPtrs[] = {
+   // Target specific versions
+   f_CMD_CONNECT                    ,//= 15, CMD_USBDM_CONNECT
+   f_CMD_SET_SPEED                  ,//= 16, CMD_USBDM_SET_SPEED
+   f_CMD_GET_SPEED                  ,//= 17, CMD_USBDM_GET_SPEED
+
+   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
+   f_CMD_ILLEGAL                    ,//= 19, RESERVED
+
+   f_CMD_READ_STATUS_REG            ,//= 20, CMD_USBDM_READ_STATUS_REG
+   f_CMD_WRITE_CONTROL_REG          ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
+
+   f_CMD_RESET                      ,//= 22, CMD_USBDM_TARGET_RESET
+   f_CMD_STEP                       ,//= 23, CMD_USBDM_TARGET_STEP
+   f_CMD_GO                         ,//= 24, CMD_USBDM_TARGET_GO
+   f_CMD_HALT                       ,//= 25, CMD_USBDM_TARGET_HALT
+
+   f_CMD_HCS08_WRITE_REG            ,//= 26, CMD_USBDM_WRITE_REG
+   f_CMD_HCS08_READ_REG             ,//= 27, CMD_USBDM_READ_REG
+
+   f_CMD_ILLEGAL                    ,//= 28, CMD_USBDM_WRITE_CREG
+   f_CMD_ILLEGAL                    ,//= 29, CMD_USBDM_READ_CREG
+
+   f_CMD_WRITE_BKPT                 ,//= 30, CMD_USBDM_WRITE_DREG
+   f_CMD_READ_BKPT                  ,//= 31, CMD_USBDM_READ_DREG
+
+   f_CMD_HCS08_WRITE_MEM            ,//= 32, CMD_USBDM_WRITE_MEM
+   f_CMD_HCS08_READ_MEM             ,//= 33, CMD_USBDM_READ_MEM
+
+#if (TARGET_CAPABILITY & CAP_RS08)
+   f_CMD_ILLEGAL                    ,//= 34, CMD_USBDM_TRIM_CLOCK - obsolete
+   f_CMD_ILLEGAL                    ,//= 35, CMD_USBDM_RS08_FLASH_ENABLE - obsolete
+   f_CMD_ILLEGAL                    ,//= 36, CMD_USBDM_RS08_FLASH_STATUS - obsolete
+   f_CMD_ILLEGAL                    ,//= 37, CMD_USBDM_RS08_FLASH_DISABLE - obsolete
+   f_CMD_ILLEGAL                    ,//= 38, CMD_USBDM_JTAG_GOTORESET
+   f_CMD_ILLEGAL                    ,//= 39, CMD_USBDM_JTAG_GOTOSHIFT
+   f_CMD_ILLEGAL                    ,//= 40, CMD_USBDM_JTAG_WRITE
+   f_CMD_ILLEGAL                    ,//= 41, CMD_USBDM_JTAG_READ
+   f_CMD_SET_VPP                    ,//= 42, CMD_USBDM_SET_VPP
+#endif
+   };
+static const FunctionPtrs HCS08FunctionPointers = {CMD_USBDM_CONNECT,
+                                                   sizeof(HCS08functionPtrs)/sizeof(FunctionPtr),
+                                                   HCS08functionPtrs};
+#endif
+
+#if (TARGET_CAPABILITY&CAP_CFV1)
+static const FunctionPtr CFV1functionPtrs[] = {
+   // Target specific versions
+   f_CMD_CONNECT                    ,//= 15, CMD_USBDM_CONNECT
+   f_CMD_SET_SPEED                  ,//= 16, CMD_USBDM_SET_SPEED
+   f_CMD_GET_SPEED                  ,//= 17, CMD_USBDM_GET_SPEED
+
+   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
+   f_CMD_ILLEGAL                    ,//= 19, RESERVED
+
+   f_CMD_READ_STATUS_REG            ,//= 20, CMD_USBDM_READ_STATUS_REG
+   f_CMD_WRITE_CONTROL_REG          ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
+
+   f_CMD_RESET                      ,//= 22, CMD_USBDM_TARGET_RESET
+   f_CMD_STEP                       ,//= 23, CMD_USBDM_TARGET_STEP
+   f_CMD_GO                         ,//= 24, CMD_USBDM_TARGET_GO
+   f_CMD_HALT                       ,//= 25, CMD_USBDM_TARGET_HALT
+
+   f_CMD_CF_WRITE_REG               ,//= 26, CMD_USBDM_WRITE_REG
+   f_CMD_CF_READ_REG                ,//= 27  CMD_USBDM_READ_REG
+
+   f_CMD_CF_WRITE_CREG              ,//= 28  CMD_USBDM_WRITE_CREG
+   f_CMD_CF_READ_CREG               ,//= 29  CMD_USBDM_READ_CREG
+
+   f_CMD_CF_WRITE_DREG              ,//= 30  CMD_USBDM_WRITE_DREG
+   f_CMD_CF_READ_DREG               ,//= 31  CMD_USBDM_READ_DREG
+
+   f_CMD_CF_WRITE_MEM               ,//= 32  CMD_USBDM_WRITE_MEM
+   f_CMD_CF_READ_MEM                ,//= 33  CMD_USBDM_READ_MEM
+   };
+static const FunctionPtrs CFV1FunctionPointers  = {CMD_USBDM_CONNECT,
+                                                   sizeof(CFV1functionPtrs)/sizeof(FunctionPtr),
+                                                   CFV1functionPtrs};
+#endif
+
+#if (TARGET_CAPABILITY&CAP_CFVx)
+static const FunctionPtr CFVxfunctionPtrs[] = {
+   // Target specific versions
+   f_CMD_CFVx_RESYNC                ,//= 15, CMD_USBDM_CONNECT
+   f_CMD_SPI_SET_SPEED              ,//= 16, CMD_USBDM_SET_SPEED
+   f_CMD_SPI_GET_SPEED              ,//= 17, CMD_USBDM_GET_SPEED
+
+   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
+   f_CMD_ILLEGAL                    ,//= 19, RESERVED
+
+   f_CMD_CFVx_READ_STATUS_REG       ,//= 20, CMD_USBDM_READ_STATUS_REG
+   f_CMD_ILLEGAL                    ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
+
+   f_CMD_CFVx_RESET                 ,//= 22, CMD_USBDM_TARGET_RESET
+   f_CMD_CFVx_STEP                  ,//= 23, CMD_USBDM_TARGET_STEP
+   f_CMD_CFVx_GO                    ,//= 24, CMD_USBDM_TARGET_GO
+   f_CMD_CFVx_HALT                  ,//= 25, CMD_USBDM_TARGET_HALT
+
+   f_CMD_CFVx_WRITE_REG             ,//= 26, CMD_USBDM_WRITE_REG
+   f_CMD_CFVx_READ_REG              ,//= 27  CMD_USBDM_READ_REG
+
+   f_CMD_CFVx_WRITE_CREG            ,//= 28  CMD_USBDM_WRITE_CREG
+   f_CMD_CFVx_READ_CREG             ,//= 29  CMD_USBDM_READ_CREG
+
+   f_CMD_CFVx_WRITE_DREG            ,//= 30  CMD_USBDM_WRITE_DREG
+   f_CMD_CFVx_READ_DREG             ,//= 31  CMD_USBDM_READ_DREG
+
+   f_CMD_CFVx_WRITE_MEM             ,//= 32  CMD_USBDM_WRITE_MEM
+   f_CMD_CFVx_READ_MEM              ,//= 33  CMD_USBDM_READ_MEM
+
+   f_CMD_ILLEGAL                    ,//= 34, CMD_USBDM_TRIM_CLOCK
+   f_CMD_ILLEGAL                    ,//= 35, CMD_USBDM_RS08_FLASH_ENABLE
+   f_CMD_ILLEGAL                    ,//= 36, CMD_USBDM_RS08_FLASH_STATUS
+   f_CMD_ILLEGAL                    ,//= 37, CMD_USBDM_RS08_FLASH_DISABLE
+   };
+static const FunctionPtrs CFVxFunctionPointers  = {CMD_USBDM_CONNECT,
+                                                   sizeof(CFVxfunctionPtrs)/sizeof(FunctionPtr),
+                                                   CFVxfunctionPtrs};
+#endif 
+
+#if (TARGET_CAPABILITY&(CAP_DSC|CAP_JTAG|CAP_ARM_JTAG))
+static const FunctionPtr JTAGfunctionPtrs[] = {
+   // Target specific versions
+   f_CMD_ILLEGAL                    ,//= 15, CMD_USBDM_CONNECT
+   f_CMD_SPI_SET_SPEED              ,//= 16, CMD_USBDM_SET_SPEED
+   f_CMD_SPI_GET_SPEED              ,//= 17, CMD_USBDM_GET_SPEED
+   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
+   f_CMD_ILLEGAL                    ,//= 19, RESERVED
+   f_CMD_ILLEGAL                    ,//= 20, CMD_USBDM_READ_STATUS_REG
+   f_CMD_ILLEGAL                    ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
+   f_CMD_JTAG_RESET                 ,//= 22, CMD_USBDM_TARGET_RESET
+   f_CMD_ILLEGAL                    ,//= 23, CMD_USBDM_TARGET_STEP
+   f_CMD_ILLEGAL                    ,//= 24, CMD_USBDM_TARGET_GO
+   f_CMD_ILLEGAL                    ,//= 25, CMD_USBDM_TARGET_HALT
+   f_CMD_ILLEGAL                    ,//= 26, CMD_USBDM_WRITE_REG
+   f_CMD_ILLEGAL                    ,//= 27  CMD_USBDM_READ_REG
+   f_CMD_ILLEGAL                    ,//= 28  CMD_USBDM_WRITE_CREG
+   f_CMD_ILLEGAL                    ,//= 29  CMD_USBDM_READ_CREG
+   f_CMD_ILLEGAL                    ,//= 30  CMD_USBDM_WRITE_DREG
+   f_CMD_ILLEGAL                    ,//= 31  CMD_USBDM_READ_DREG
+   f_CMD_ILLEGAL                    ,//= 32  CMD_USBDM_WRITE_MEM
+   f_CMD_ILLEGAL                    ,//= 33  CMD_USBDM_READ_MEM
+   f_CMD_ILLEGAL                    ,//= 34, CMD_USBDM_TRIM_CLOCK
+   f_CMD_ILLEGAL                    ,//= 35, CMD_USBDM_RS08_FLASH_ENABLE
+   f_CMD_ILLEGAL                    ,//= 36, CMD_USBDM_RS08_FLASH_STATUS
+   f_CMD_ILLEGAL                    ,//= 37, CMD_USBDM_RS08_FLASH_DISABLE
+   f_CMD_JTAG_GOTORESET             ,//= 38, CMD_USBDM_JTAG_GOTORESET
+   f_CMD_JTAG_GOTOSHIFT             ,//= 39, CMD_USBDM_JTAG_GOTOSHIFT
+   f_CMD_JTAG_WRITE                 ,//= 40, CMD_USBDM_JTAG_WRITE
+   f_CMD_JTAG_READ                  ,//= 41, CMD_USBDM_JTAG_READ
+   f_CMD_ILLEGAL                    ,//= 42, CMD_USBDM_SET_VPP
+   f_CMD_JTAG_READ_WRITE            ,//= 43, CMD_USBDM_JTAG_READ_WRITE
+   f_CMD_JTAG_EXECUTE_SEQUENCE      ,//= 44, CMD_JTAG_EXECUTE_SEQUENCE
+   };
+static const FunctionPtrs JTAGFunctionPointers   = {CMD_USBDM_CONNECT,
+                                                    sizeof(JTAGfunctionPtrs)/sizeof(FunctionPtr),     
+                                                    JTAGfunctionPtrs};
+#endif 
+
+#if (TARGET_CAPABILITY&CAP_ARM_SWD)
+static const FunctionPtr SWDfunctionPtrs[] = {
+   // Target specific versions
+   // Target specific versions
+   f_CMD_SWD_CONNECT                ,//= 15, CMD_USBDM_CONNECT
+   f_CMD_SPI_SET_SPEED              ,//= 16, CMD_USBDM_SET_SPEED
+   f_CMD_SPI_GET_SPEED              ,//= 17, CMD_USBDM_GET_SPEED
+   f_CMD_ILLEGAL                    ,//= 18, CMD_USBDM_CONTROL_INTERFACE
+   f_CMD_ILLEGAL                    ,//= 19, RESERVED
+   f_CMD_ILLEGAL                    ,//= 20, CMD_USBDM_READ_STATUS_REG
+   f_CMD_ILLEGAL                    ,//= 21, CMD_USBDM_WRITE_CONTROL_REG
+   f_CMD_ILLEGAL                    ,//= 22, CMD_USBDM_TARGET_RESET
+   f_CMD_SWD_TARGET_STEP            ,//= 23, CMD_USBDM_TARGET_STEP
+   f_CMD_SWD_TARGET_GO              ,//= 24, CMD_USBDM_TARGET_GO
+   f_CMD_SWD_TARGET_HALT            ,//= 25, CMD_USBDM_TARGET_HALT
+   f_CMD_SWD_WRITE_REG              ,//= 26, CMD_USBDM_WRITE_REG
+   f_CMD_SWD_READ_REG               ,//= 27  CMD_USBDM_READ_REG
+   f_CMD_SWD_WRITE_CREG             ,//= 28  CMD_USBDM_WRITE_CREG
+   f_CMD_SWD_READ_CREG              ,//= 29  CMD_USBDM_READ_CREG
+   f_CMD_SWD_WRITE_DREG             ,//= 30  CMD_USBDM_WRITE_DREG
+   f_CMD_SWD_READ_DREG              ,//= 31  CMD_USBDM_READ_DREG
+   f_CMD_SWD_WRITE_MEM              ,//= 32  CMD_USBDM_WRITE_MEM
+   f_CMD_SWD_READ_MEM               ,//= 33  CMD_USBDM_READ_MEM
+   };
+static const FunctionPtrs SWDFunctionPointers   = {CMD_USBDM_CONNECT,
+                                                    sizeof(SWDfunctionPtrs)/sizeof(FunctionPtr),     
+                                                    SWDfunctionPtrs};
+#endif 
+
+//! Extended commands - common to all targets
+//! These are built upon the target specific commands e.g. CMD_USBDM_READ_MEM
+static const FunctionPtr extendedFunctionPtrs[] = {
+   f_CMD_READ_MEM_STREAM            ,//= 45, CMD_USBDM_READ_MEM_STREAM
+   f_CMD_EXECUTE_BATCH              ,//= 46, CMD_USBDM_EXECUTE_BATCH
+   f_CMD_CRC_MEM                    ,//= 47, CMD_USBDM_CRC_MEM
+   f_CMD_FILL_MEM                   ,//= 48, CMD_USBDM_FILL_MEM
+   f_CMD_VERIFY_MEM                 ,//= 49, CMD_USBDM_VERIFY_MEM
+   f_CMD_READ_MEM_GATHER            ,//= 50, CMD_USBDM_READ_MEM_GATHER
+   f_CMD_POLL_MEM                   ,//= 51, CMD_USBDM_POLL_MEM
+   f_CMD_MODIFY_MEM                 ,//= 52, CMD_USBDM_MODIFY_MEM
+   f_CMD_HASH_MEM                   ,//= 53, CMD_USBDM_HASH_MEM
+   f_CMD_READ_MEM_RLE               ,//= 54, CMD_USBDM_READ_MEM_RLE
+   f_CMD_WRITE_MEM_RLE              ,//= 55, CMD_USBDM_WRITE_MEM_RLE
+#if READ_CACHE
+   f_CMD_SET_READ_CACHE             ,//= 56, CMD_USBDM_SET_READ_CACHE
+#else
+   f_CMD_ILLEGAL                    ,//= 56, CMD_USBDM_SET_READ_CACHE
+#endif
+   };
+static const FunctionPtrs extendedFunctionPointers = {CMD_USBDM_READ_MEM_STREAM,
+                                                      sizeof(extendedFunctionPtrs)/sizeof(FunctionPtr),
+                                                      extendedFunctionPtrs};
+
+//! Ptr to function table for current target type
+static const FunctionPtrs *currentFunctions = NULL; // default to empty
+
+//! Get target specific command function
+//!
+//! @param command - command to look up
+//!
+//! @return ptr to function for current target (f_CMD_ILLEGAL if none)
+//!
+static FunctionPtr getTargetFunction(U8 command) {
+   if (currentFunctions != NULL) {
+      int commandIndex = command - currentFunctions->firstCommand;
+      if ((commandIndex >= 0) && (commandIndex < currentFunctions->size))
+         return currentFunctions->functions[commandIndex];
+   }
+   return f_CMD_ILLEGAL;
+}
+
+//! Set target type
+//! Initialise interface for given target
+//! @note
+//!   commandBuffer        \n
+//!   - [2] = target type
+//!
+U8 f_CMD_SET_TARGET(void) {
+U8 target = commandBuffer[2];
+
+   readCacheInvalidate();
+   switch (target) {
+#if (TARGET_CAPABILITY&CAP_HCS12)
+   case T_HC12:
+         currentFunctions = &HCS12FunctionPointers;
+         break;
+#endif
+#if (TARGET_CAPABILITY&CAP_HCS08)
+      case T_HCS08:
+         currentFunctions = &HCS08FunctionPointers;
+         break;
+#endif
+#if (TARGET_CAPABILITY & CAP_RS08)
+      case T_RS08:
+          currentFunctions = &HCS08FunctionPointers;
+          break;
+#endif
+#if (TARGET_CAPABILITY & CAP_CFV1)
+      case T_CFV1:
+         currentFunctions = &CFV1FunctionPointers;
+         break;
+#endif         
+#if (TARGET_CAPABILITY&CAP_CFVx)
+      case T_CFVx:
+         currentFunctions = &CFVxFunctionPointers;
+         break;
+#endif
+#if (TARGET_CAPABILITY&CAP_JTAG)
+      case T_JTAG:
+         currentFunctions = &JTAGFunctionPointers;
+         break;
+#endif
+#if (TARGET_CAPABILITY&CAP_DSC)
+      case T_MC56F80xx:
+         currentFunctions = &JTAGFunctionPointers;
+         break;
+#endif
+#if (TARGET_CAPABILITY&CAP_ARM_JTAG)
+      case T_ARM_JTAG:
+         currentFunctions = &JTAGFunctionPointers;
+         break;
+#endif
+#if (TARGET_CAPABILITY&CAP_ARM_SWD)
+      case T_ARM_SWD:
+         currentFunctions = &SWDFunctionPointers;
+         break;
+#endif
+      case T_OFF:
+         currentFunctions = NULL;
+         break;
+         
+      default:
+         currentFunctions = NULL;
+         (void)bdm_setTarget(T_OFF);
+         return BDM_RC_UNKNOWN_TARGET; 
+   }
+   return bdm_setTarget(target);
+}
+
+//! Read a block of target memory using the target's CMD_USBDM_READ_MEM
+//!
+//! @param readMem     - target's CMD_USBDM_READ_MEM function
+//! @param elementSize - element size/memory space
+//! @param address     - address in target memory
+//! @param size        - # of bytes (<= MAX_COMMAND_SIZE-1)
+//!
+//! @return
+//!    error code \n
+//!    commandBuffer[1..size] = data read
+//!
+static U8 readTargetMemory(FunctionPtr readMem, U8 elementSize, U32 address, U8 size) {
+   // Build READ_MEM command for this piece
+   commandBuffer[2]         = elementSize;
+   commandBuffer[3]         = size;
+   *(U32*)(commandBuffer+4) = address;
+   return readMem();
+}
+
+//! Write a block of target memory using the target's CMD_USBDM_WRITE_MEM
+//!
+//! @param writeMem    - target's CMD_USBDM_WRITE_MEM function
+//! @param elementSize - element size/memory space
+//! @param address     - address in target memory
+//! @param size        - # of bytes (<= MAX_COMMAND_SIZE-8)
+//!
+//! @return
+//!    error code
+//!
+//! @note The data must already be in commandBuffer[8..]
+//!
+static U8 writeTargetMemory(FunctionPtr writeMem, U8 elementSize, U32 address, U8 size) {
+   // Build WRITE_MEM command for this piece
+   commandBuffer[2]         = elementSize;
+   commandBuffer[3]         = size;
+   *(U32*)(commandBuffer+4) = address;
+   return writeMem();
+}
+
+//! Check the element size & alignment of a range of target memory
+//!
+//! @param elementSize - element size/memory space
+//! @param address     - start address in target memory
+//! @param count       - # of bytes
+//!
+//! @return
+//!    == \ref BDM_RC_OK             => element size is 1, 2 or 4 and address & count are multiples of it \n
+//!    == \ref BDM_RC_ILLEGAL_PARAMS => otherwise
+//!
+static U8 checkMemoryRange(U8 elementSize, U32 address, U32 count) {
+U8 sizeMask = (elementSize&MS_SIZE)-1;
+
+   if ((sizeMask != MS_Byte-1) && (sizeMask != MS_Word-1) && (sizeMask != MS_Long-1))
+      return BDM_RC_ILLEGAL_PARAMS;
+   if ((((U8)address|(U8)count)&sizeMask) != 0)
+      return BDM_RC_ILLEGAL_PARAMS;
+   return BDM_RC_OK;
+}
+
+//! Record progress after each chunk of a multi-chunk memory command & check for abort
+//!
+//! The target's READ_MEM/WRITE_MEM may count its own progress so the
+//! total is set rather than added to.
+//!
+//! @param done - # of bytes completed by the command so far
+//!
+//! @return
+//!    == \ref BDM_RC_OK      => continue \n
+//!    == \ref BDM_RC_ABORTED => host has requested an abort
+//!
+static U8 chunkProgress(U32 done) {
+   setCommandProgress(done);
+   if (commandAbort)
+      return BDM_RC_ABORTED;
+   return BDM_RC_OK;
+}
+
+//! Number of bytes read from the target for each stream pkt
+#define STREAM_CHUNK_SIZE  (USB_STREAM_PACKET_SIZE)
+//! Stream ring buffer is placed in commandBuffer after the area used by CMD_USBDM_READ_MEM
+//!
+//! This is safe as:
+//!  - The target's READ_MEM only uses commandBuffer[2..7] (parameters) & [1..chunk] (data).
+//!    The range is checked by checkMemoryRange() so each chunk is a whole number of
+//!    elements & no READ_MEM writes past [chunk] (e.g. ARM word reads of an odd count would).
+//!  - commandBuffer is not reused for the next command until EP2 has copied the
+//!    last pkt of the stream (receiveUSBCommand() waits for the buffer release).
+#define STREAM_RING_OFFSET (1+STREAM_CHUNK_SIZE)
+//! Number of pkts in stream ring buffer
+#define STREAM_RING_SLOTS  ((MAX_COMMAND_SIZE-STREAM_RING_OFFSET)/USB_STREAM_PACKET_SIZE)
+
+#if (STREAM_RING_SLOTS < 1) || (STREAM_RING_SLOTS > USB_STREAM_MAX_SLOTS)
+#error "commandBuffer unsuitable for stream ring buffer"
+#endif
+#if ((STREAM_CHUNK_SIZE%4) != 0) || (STREAM_RING_OFFSET < 8) || \
+    (STREAM_RING_OFFSET+STREAM_RING_SLOTS*USB_STREAM_PACKET_SIZE > MAX_COMMAND_SIZE)
+#error "Stream ring buffer overlaps READ_MEM area or overruns commandBuffer"
+#endif
+
+//! Read a large block of target memory as a multi-packet stream
+//!
+//! The memory is read using the target's CMD_USBDM_READ_MEM in
+//! pkt sized pieces while earlier pieces are being sent.
+//!
+//! @note
+//!  commandBuffer                           \n
+//!  - [2]    = element size/memory space    \n
+//!  - [3]    = unused                       \n
+//!  - [4..7] = address                      \n
+//!  - [8..9] = # of bytes (1..65535, address & # of bytes must be multiples of element size)
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  Response is a single transfer terminated by an undersize pkt  \n
+//!  - [0]      = BDM_RC_OK                  \n
+//!  - [1..N]   = data read                  \n
+//!  - [N+1]    = final status               \n
+//!  On a target error or abort the data is truncated (N < # of bytes) and the final
+//!  status is the error code.  Errors found before any target access (illegal
+//!  parameters etc.) are returned as a normal (single byte) response.
+//!
+U8 f_CMD_READ_MEM_STREAM(void) {
+FunctionPtr readMem     = getTargetFunction(CMD_USBDM_READ_MEM);
+U8          elementSize = commandBuffer[2];
+U32         address     = *(U32*)(commandBuffer+4);
+U16         count       = *(U16*)(commandBuffer+8);
+U32         done        = 0;
+U8          status;
+U8          chunk;
+U8          rc;
+
+   if (readMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   if (count == 0)
+      return BDM_RC_ILLEGAL_PARAMS;
+   rc = checkMemoryRange(elementSize, address, count);
+   if (rc != BDM_RC_OK)
+      return rc;
+
+   startUSBStream(commandBuffer+STREAM_RING_OFFSET, STREAM_RING_SLOTS);
+   status = BDM_RC_OK|commandToggle;
+   putUSBStream(1, &status); // Response status
+   while (count > 0) {
+      chunk = STREAM_CHUNK_SIZE;
+      if (count < chunk)
+         chunk = (U8)count;
+      rc = readTargetMemory(readMem, elementSize, address, chunk);
+      if (rc != BDM_RC_OK)
+         break;
+      putUSBStream(chunk, commandBuffer+1);
+      address += chunk;
+      count   -= chunk;
+      done    += chunk;
+      rc = chunkProgress(done);
+      if (rc != BDM_RC_OK)
+         break;
+   }
+   status = rc;
+   putUSBStream(1, &status); // Final status
+   endUSBStream();
+   returnSize = 0; // Response has already been sent
+   return rc;
+}
+
+//! CRC32 nibble table (polynomial 0xEDB88320, reflected)
+static const U32 crc32Table[16] = {
+   0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+   0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+   0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+   0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+};
+
+//! Update CRC32 with a block of data
+//!
+//! @param crc    - CRC so far (initially 0xFFFFFFFF)
+//! @param data   - data to add
+//! @param size   - # of bytes
+//!
+//! @return updated CRC (complement for final value)
+//!
+static U32 crc32Update(U32 crc, const U8 *data, U8 size) {
+   while (size-- > 0) {
+      crc ^= *data++;
+      crc  = (crc>>4) ^ crc32Table[(U8)crc&0x0F];
+      crc  = (crc>>4) ^ crc32Table[(U8)crc&0x0F];
+   }
+   return crc;
+}
+
+//! Number of bytes read from the target for each CRC block (multiple of 4)
+#define CRC_CHUNK_SIZE ((MAX_COMMAND_SIZE-1)&~3)
+
+//! Calculate CRC32 of a range of target memory
+//!
+//! The memory is read using the target's CMD_USBDM_READ_MEM so only
+//! the result is returned over USB.  The CRC is the same as zlib crc32().
+//!
+//! @note
+//!  commandBuffer                           \n
+//!  - [2]     = element size/memory space   \n
+//!  - [3]     = unused                      \n
+//!  - [4..7]  = address                     \n
+//!  - [8..11] = # of bytes (address & # of bytes must be multiples of element size)
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..4] = CRC32
+//!
+U8 f_CMD_CRC_MEM(void) {
+FunctionPtr readMem     = getTargetFunction(CMD_USBDM_READ_MEM);
+U8          elementSize = commandBuffer[2];
+U32         address     = *(U32*)(commandBuffer+4);
+U32         count       = *(U32*)(commandBuffer+8);
+U32         crc         = 0xFFFFFFFFUL;
+U32         done        = 0;
+U8          chunk;
+U8          rc;
+
+   if (readMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   rc = checkMemoryRange(elementSize, address, count);
+   if (rc != BDM_RC_OK)
+      return rc;
+
+   while (count > 0) {
+      chunk = CRC_CHUNK_SIZE;
+      if (count < chunk)
+         chunk = (U8)count;
+      rc = readTargetMemory(readMem, elementSize, address, chunk);
+      if (rc != BDM_RC_OK)
+         return rc;
+      crc      = crc32Update(crc, commandBuffer+1, chunk);
+      address += chunk;
+      count   -= chunk;
+      done    += chunk;
+      rc = chunkProgress(done);
+      if (rc != BDM_RC_OK)
+         return rc;
+   }
+   *(U32*)(commandBuffer+1) = ~crc;
+   returnSize = 5;
+   return BDM_RC_OK;
+}
+
+//! Number of bytes written to the target for each fill block (multiple of 4)
+#define FILL_CHUNK_SIZE ((MAX_COMMAND_SIZE-8)&~3)
+
+//! Fill a range of target memory with a repeated element
+//!
+//! The memory is written using the target's CMD_USBDM_WRITE_MEM so each
+//! target uses its usual (auto-incrementing) write sequence.
+//!
+//! @note
+//!  commandBuffer                            \n
+//!  - [2]      = element size/memory space   \n
+//!  - [3]      = unused                      \n
+//!  - [4..7]   = address                     \n
+//!  - [8..11]  = # of bytes (address & # of bytes must be multiples of element size) \n
+//!  - [12..15] = pattern, 1st element size bytes are used (as WRITE_MEM data)
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error
+//!
+U8 f_CMD_FILL_MEM(void) {
+FunctionPtr writeMem    = getTargetFunction(CMD_USBDM_WRITE_MEM);
+U8          elementSize = commandBuffer[2];
+U32         address     = *(U32*)(commandBuffer+4);
+U32         count       = *(U32*)(commandBuffer+8);
+U8          sizeMask    = (elementSize&MS_SIZE)-1;
+U32         done        = 0;
+U8          pattern[4];
+U8          chunk;
+U8          index;
+U8          rc;
+
+   if (writeMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   rc = checkMemoryRange(elementSize, address, count);
+   if (rc != BDM_RC_OK)
+      return rc;
+   if (commandBuffer[0] < 12+sizeMask+1)
+      return BDM_RC_ILLEGAL_PARAMS;  // Pattern missing
+
+   // Replicate pattern through the data area - this isn't changed by WRITE_MEM
+   (void)memcpy(pattern, commandBuffer+12, sizeof(pattern));
+   for (index=0; index<FILL_CHUNK_SIZE; index++)
+      commandBuffer[8+index] = pattern[index&sizeMask];
+
+   while (count > 0) {
+      chunk = FILL_CHUNK_SIZE;
+      if (count < chunk)
+         chunk = (U8)count;
+      rc = writeTargetMemory(writeMem, elementSize, address, chunk);
+      if (rc != BDM_RC_OK)
+         return rc;
+      address += chunk;
+      count   -= chunk;
+      done    += chunk;
+      rc = chunkProgress(done);
+      if (rc != BDM_RC_OK)
+         return rc;
+   }
+   return BDM_RC_OK;
+}
+
+//! Maximum # of bytes compared by CMD_USBDM_VERIFY_MEM
+#define VERIFY_MAX_SIZE (MAX_COMMAND_SIZE-9)
+
+//! Compare a block of target memory with data
+//!
+//! The memory is read using the target's CMD_USBDM_READ_MEM and compared
+//! on the BDM so the data is not returned over USB.
+//!
+//! @note
+//!  commandBuffer                            \n
+//!  - [2]      = element size/memory space   \n
+//!  - [3]      = # of bytes                  \n
+//!  - [4..7]   = address                     \n
+//!  - [8]      = options see \ref VerifyOptions_t \n
+//!  - [9..N]   = expected data (as WRITE_MEM data)
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success (memory was read, may not match) \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..2] = byte offset of 1st mismatching element, 0xFFFF => all match, or \n
+//!  - [1..N] = bitmap, bit n (LSB first) set => element n mismatched (VERIFY_BITMAP)
+//!
+U8 f_CMD_VERIFY_MEM(void) {
+FunctionPtr readMem       = getTargetFunction(CMD_USBDM_READ_MEM);
+U8          elementSize   = commandBuffer[2];
+U8          count         = commandBuffer[3];
+U32         address       = *(U32*)(commandBuffer+4);
+U8          options       = commandBuffer[8];
+U8          sizeMask      = (elementSize&MS_SIZE)-1;
+U8          sizeShift     = sizeMask-(sizeMask>>1);  // log2(element size)
+U16         firstMismatch = 0xFFFF;
+U8          bitmap[(VERIFY_MAX_SIZE+7)/8];
+U8          expected;    // Start of remaining expected data
+U8          offset = 0;  // Offset of data being compared
+U8          chunk;
+U8          index;
+U8          element;
+U8          rc;
+
+   if (readMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   if ((sizeMask != MS_Byte-1) && (sizeMask != MS_Word-1) && (sizeMask != MS_Long-1))
+      return BDM_RC_ILLEGAL_PARAMS;
+   if ((count > VERIFY_MAX_SIZE) || ((count&sizeMask) != 0))
+      return BDM_RC_ILLEGAL_PARAMS;
+   if (commandBuffer[0] < 9+count)
+      return BDM_RC_ILLEGAL_PARAMS;  // Expected data missing
+
+   // Move expected data to end of buffer.  The target is read into the start of
+   // the buffer in pieces that grow as the expected data is consumed
+   //
+   //  +----------+----------------------+---------------+
+   //  | Read     | (Consumed)           | Expected data |
+   //  +----------+----------------------+---------------+
+   //
+   expected = MAX_COMMAND_SIZE-count;
+   (void)memmove(commandBuffer+expected, commandBuffer+9, count);
+   (void)memset(bitmap, 0, sizeof(bitmap));
+   while (offset < count) {
+      chunk = (expected-1)&~3;
+      if (chunk > count-offset)
+         chunk = count-offset;
+      rc = readTargetMemory(readMem, elementSize, address+offset, chunk);
+      if (rc != BDM_RC_OK)
+         return rc;
+      for (index=0; index<chunk; index++) {
+         if (commandBuffer[1+index] != commandBuffer[expected+index]) {
+            element = (offset+index)>>sizeShift;
+            bitmap[element>>3] |= 1<<(element&0x07);
+            if (firstMismatch == 0xFFFF)
+               firstMismatch = (offset+index)&~sizeMask;
+         }
+      }
+      expected += chunk;
+      offset   += chunk;
+   }
+   if (options&VERIFY_BITMAP) {
+      index = ((count>>sizeShift)+7)>>3;
+      (void)memcpy(commandBuffer+1, bitmap, index);
+      returnSize = index+1;
+   }
+   else {
+      *(U16*)(commandBuffer+1) = firstMismatch;
+      returnSize = 3;
+   }
+   return BDM_RC_OK;
+}
+
+//! Size of each region descriptor for CMD_USBDM_READ_MEM_GATHER
+#define GATHER_DESCRIPTOR_SIZE (6)
+
+//! Read a list of target memory regions
+//!
+//! Each region is read using the target's CMD_USBDM_READ_MEM and the
+//! data for all regions is returned in a single response.
+//!
+//! @note
+//!  commandBuffer                            \n
+//!  - [2]      = # of regions                \n
+//!  - [3..N]   = region descriptors, each:   \n
+//!    - [0]    = element size/memory space   \n
+//!    - [1]    = # of bytes                  \n
+//!    - [2..5] = address
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..N] = data read from each region in order
+//!
+//! @note The data for each region must fit in the buffer with the
+//!       remaining descriptors and results.  All descriptors are checked
+//!       before any target access.
+//!
+U8 f_CMD_READ_MEM_GATHER(void) {
+FunctionPtr readMem    = getTargetFunction(CMD_USBDM_READ_MEM);
+U8          numRegions = commandBuffer[2];
+U8          descStart;                     // Start of remaining descriptors
+U8          desc;
+U8          resStart   = MAX_COMMAND_SIZE; // Start of results (end of descriptors)
+U8          elementSize;
+U8          count;
+U16         resSize;                       // Space taken by results so far
+U32         address;
+U8          rc;
+
+   if (readMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   if ((numRegions == 0) || (numRegions > (MAX_COMMAND_SIZE-3)/GATHER_DESCRIPTOR_SIZE))
+      return BDM_RC_ILLEGAL_PARAMS;
+   if (commandBuffer[0] < 3+numRegions*GATHER_DESCRIPTOR_SIZE)
+      return BDM_RC_ILLEGAL_PARAMS;  // Descriptors missing
+
+   // Move descriptors to end of buffer.  Results are then kept after the
+   // descriptors and the start of the buffer is used to read each region
+   //
+   //  +----------+------------------------+---------+
+   //  | Read     | Remaining descriptors  | Results |
+   //  +----------+------------------------+---------+
+   //
+   descStart = MAX_COMMAND_SIZE-numRegions*GATHER_DESCRIPTOR_SIZE;
+   (void)memmove(commandBuffer+descStart, commandBuffer+3, resStart-descStart);
+
+   // Check every region before reading any of them.
+   // Read (including READ_MEM parameters [2..7]) and its result must fit before remaining descriptors
+   resSize = 0;
+   for (desc=descStart; desc<resStart; desc+=GATHER_DESCRIPTOR_SIZE) {
+      count = commandBuffer[desc+1];
+      if ((count == 0) ||
+          (resSize+8 > desc+GATHER_DESCRIPTOR_SIZE) ||
+          (resSize+2*count+1 > desc+GATHER_DESCRIPTOR_SIZE))
+         return BDM_RC_ILLEGAL_PARAMS;
+      resSize += count;
+   }
+   while (descStart < resStart) {
+      elementSize = commandBuffer[descStart];
+      count       = commandBuffer[descStart+1];
+      address     = *(U32*)(commandBuffer+descStart+2);
+      descStart  += GATHER_DESCRIPTOR_SIZE;
+      rc = readTargetMemory(readMem, elementSize, address, count);
+      if (rc != BDM_RC_OK)
+         return rc;
+      // Move remaining descriptors & results down to make room for new result
+      (void)memmove(commandBuffer+descStart-count, commandBuffer+descStart, MAX_COMMAND_SIZE-descStart);
+      descStart -= count;
+      resStart  -= count;
+      // Append result
+      (void)memcpy(commandBuffer+MAX_COMMAND_SIZE-count, commandBuffer+1, count);
+   }
+   // Move results to start of buffer
+   count = MAX_COMMAND_SIZE-resStart;
+   (void)memmove(commandBuffer+1, commandBuffer+resStart, count);
+   returnSize = count+1;
+   return BDM_RC_OK;
+}
+
+//! Poll a target memory location until a condition is met or timeout
+//!
+//! The location is read repeatedly using the target's CMD_USBDM_READ_MEM
+//! until (value & mask) == expected.  Mask and expected are in the same
+//! byte order as READ_MEM data.
+//! The timeout is measured by both the USB frame count and the timer so the
+//! command ends even if SOFs stop (e.g. USB suspend).
+//!
+//! @note
+//!  commandBuffer                            \n
+//!  - [2]      = element size/memory space (1, 2 or 4 bytes) \n
+//!  - [3]      = unused                      \n
+//!  - [4..7]   = address                     \n
+//!  - [8..11]  = mask, 1st element size bytes are used \n
+//!  - [12..15] = expected value, 1st element size bytes are used \n
+//!  - [16..17] = timeout in ms
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success (condition may not be met) \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1]    = 1 => condition met, 0 => timeout \n
+//!  - [2..3] = # of reads (saturates at 0xFFFF) \n
+//!  - [4..N] = final value read
+//!
+U8 f_CMD_POLL_MEM(void) {
+FunctionPtr readMem     = getTargetFunction(CMD_USBDM_READ_MEM);
+U8          elementSize = commandBuffer[2];
+U8          size        = elementSize&MS_SIZE;
+U32         address     = *(U32*)(commandBuffer+4);
+U16         timeout     = *(U16*)(commandBuffer+16);
+U32         timeoutTicks;
+U32         elapsedTicks = 0;
+U16         startTime   = usbFrameCount;
+U16         lastTicks   = TPMCNT;
+U16         ticks;
+U16         iterations  = 0;
+U8          mask[4];
+U8          expected[4];
+U8          met;
+U8          index;
+U8          rc;
+
+   if (readMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   if ((size != MS_Byte) && (size != MS_Word) && (size != MS_Long))
+      return BDM_RC_ILLEGAL_PARAMS;
+   if (commandBuffer[0] < 18)
+      return BDM_RC_ILLEGAL_PARAMS;  // Parameters missing
+   (void)memcpy(mask,     commandBuffer+8,  sizeof(mask));
+   (void)memcpy(expected, commandBuffer+12, sizeof(expected));
+   timeoutTicks = timeout*(U32)TIMER_MICROSECOND(1000);
+   for(;;) {
+      rc = readTargetMemory(readMem, elementSize, address, size);
+      if (rc != BDM_RC_OK)
+         return rc;
+      if (iterations < 0xFFFF)
+         iterations++;
+      met = TRUE;
+      for (index=0; index<size; index++) {
+         if ((commandBuffer[1+index]&mask[index]) != expected[index])
+            met = FALSE;
+      }
+      // Each read is much shorter than the timer period so TPMCNT differences are exact
+      ticks         = TPMCNT;
+      elapsedTicks += (U16)(ticks-lastTicks);
+      lastTicks     = ticks;
+      if (met || ((U16)(usbFrameCount-startTime) >= timeout) || (elapsedTicks >= timeoutTicks))
+         break;
+      if (commandAbort)
+         return BDM_RC_ABORTED;
+   }
+   // Move value read after result flag & count
+   (void)memmove(commandBuffer+4, commandBuffer+1, size);
+   commandBuffer[1]         = met;
+   *(U16*)(commandBuffer+2) = iterations;
+   returnSize = 4+size;
+   return BDM_RC_OK;
+}
+
+//! Read-modify-write a target memory location
+//!
+//! The location is read and written back immediately using the target's
+//! CMD_USBDM_READ_MEM & CMD_USBDM_WRITE_MEM.  This is not atomic with respect
+//! to a running target but avoids the round trip between the accesses.
+//! Masks are in the same byte order as READ_MEM data.
+//!
+//! @note
+//!  commandBuffer                            \n
+//!  - [2]      = element size/memory space (1, 2 or 4 bytes) \n
+//!  - [3]      = unused                      \n
+//!  - [4..7]   = address                     \n
+//!  - [8..11]  = AND-mask, 1st element size bytes are used \n
+//!  - [12..15] = OR-mask, 1st element size bytes are used
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..N] = original value
+//!
+U8 f_CMD_MODIFY_MEM(void) {
+FunctionPtr readMem     = getTargetFunction(CMD_USBDM_READ_MEM);
+FunctionPtr writeMem    = getTargetFunction(CMD_USBDM_WRITE_MEM);
+U8          elementSize = commandBuffer[2];
+U8          size        = elementSize&MS_SIZE;
+U32         address     = *(U32*)(commandBuffer+4);
+U8          andMask[4];
+U8          orMask[4];
+U8          original[4];
+U8          index;
+U8          rc;
+
+   if ((readMem == f_CMD_ILLEGAL) || (writeMem == f_CMD_ILLEGAL))
+      return BDM_RC_ILLEGAL_COMMAND;
+   if ((size != MS_Byte) && (size != MS_Word) && (size != MS_Long))
+      return BDM_RC_ILLEGAL_PARAMS;
+   if (commandBuffer[0] < 16)
+      return BDM_RC_ILLEGAL_PARAMS;  // Parameters missing
+   (void)memcpy(andMask, commandBuffer+8,  sizeof(andMask));
+   (void)memcpy(orMask,  commandBuffer+12, sizeof(orMask));
+   rc = readTargetMemory(readMem, elementSize, address, size);
+   if (rc != BDM_RC_OK)
+      return rc;
+   for (index=0; index<size; index++) {
+      original[index]        = commandBuffer[1+index];
+      commandBuffer[8+index] = (original[index]&andMask[index])|orMask[index];
+   }
+   rc = writeTargetMemory(writeMem, elementSize, address, size);
+   if (rc != BDM_RC_OK)
+      return rc;
+   (void)memcpy(commandBuffer+1, original, size);
+   returnSize = 1+size;
+   return BDM_RC_OK;
+}
+
+//! Calculate Fletcher-16 checksum of a block of data
+//!
+//! @param data - data to check
+//! @param size - # of bytes
+//!
+//! @return checksum, sum2 in MSB, sum1 in LSB (sums modulo 255)
+//!
+static U16 fletcher16(const U8 *data, U8 size) {
+U16 sum1 = 0;
+U16 sum2 = 0;
+
+   while (size-- > 0) {
+      sum1 += *data++;
+      if (sum1 >= 255)
+         sum1 -= 255;
+      sum2 += sum1;
+      if (sum2 >= 255)
+         sum2 -= 255;
+   }
+   return (sum2<<8)|sum1;
+}
+
+//! Calculate a hash of each block in a range of target memory
+//!
+//! Each block is read using the target's CMD_USBDM_READ_MEM and only a
+//! Fletcher-16 checksum is returned so the host can re-read changed blocks.
+//!
+//! @note
+//!  commandBuffer                            \n
+//!  - [2]      = element size/memory space   \n
+//!  - [3]      = block size in bytes (address & block size must be multiples of element size) \n
+//!  - [4..7]   = address                     \n
+//!  - [8..9]   = # of blocks
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..N] = 16-bit checksum for each block
+//!
+//! @note Block size is limited to MAX_COMMAND_SIZE-1-2*(# of blocks)
+//!
+U8 f_CMD_HASH_MEM(void) {
+FunctionPtr readMem     = getTargetFunction(CMD_USBDM_READ_MEM);
+U8          elementSize = commandBuffer[2];
+U8          blockSize   = commandBuffer[3];
+U32         address     = *(U32*)(commandBuffer+4);
+U16         numBlocks   = *(U16*)(commandBuffer+8);
+U32         done        = 0;
+U8          hashStart;   // Checksums are kept at end of buffer
+U8          hashPtr;
+U8          rc;
+
+   if (readMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   rc = checkMemoryRange(elementSize, address, blockSize);
+   if (rc != BDM_RC_OK)
+      return rc;
+   if ((numBlocks == 0) || (numBlocks > (MAX_COMMAND_SIZE-8)/2))
+      return BDM_RC_ILLEGAL_PARAMS;
+   hashStart = MAX_COMMAND_SIZE-2*(U8)numBlocks;
+   if ((blockSize == 0) || (blockSize >= hashStart))
+      return BDM_RC_ILLEGAL_PARAMS;  // Block would overwrite checksums
+
+   for (hashPtr=hashStart; hashPtr<MAX_COMMAND_SIZE; hashPtr+=2) {
+      rc = readTargetMemory(readMem, elementSize, address, blockSize);
+      if (rc != BDM_RC_OK)
+         return rc;
+      *(U16*)(commandBuffer+hashPtr) = fletcher16(commandBuffer+1, blockSize);
+      address += blockSize;
+      done    += blockSize;
+      rc = chunkProgress(done);
+      if (rc != BDM_RC_OK)
+         return rc;
+   }
+   // Move checksums to start of buffer
+   (void)memmove(commandBuffer+1, commandBuffer+hashStart, 2*numBlocks);
+   returnSize = 1+2*numBlocks;
+   return BDM_RC_OK;
+}
+
+//! Number of bytes read from the target for each piece to encode
+#define RLE_CHUNK_SIZE   (64)
+//! Encoded data is built after the area used to read each piece
+#define RLE_OUTPUT_START (1+RLE_CHUNK_SIZE)
+//! Most encoded data added by a piece including its final flush: the piece, the run
+//! pending from the previous piece (2 bytes) and up to 2 literal control bytes
+#define RLE_PIECE_MAX    (RLE_CHUNK_SIZE+4)
+
+#if (RLE_OUTPUT_START+RLE_PIECE_MAX > MAX_COMMAND_SIZE)
+#error "RLE_CHUNK_SIZE unsuitable"
+#endif
+
+//! State of the run-length encoder, see \ref RLE_Encoding
+//!
+//! The pending run and the current literal carry over from one piece
+//! to the next so a run or literal may span many pieces
+//!
+typedef struct {
+   U8 outPtr;      //!< Next free byte of encoded data in commandBuffer
+   U8 literalPtr;  //!< Control byte of current literal in commandBuffer, 0 => none
+   U8 runLength;   //!< # of bytes in pending run, 0 => none
+   U8 runValue;    //!< Value repeated in pending run
+} RleEncoder_t;
+
+//! Add a byte to the current literal (starting a new one if necessary)
+//!
+//! @param enc   - encoder state
+//! @param value - byte to add
+//!
+static void rleAddLiteral(RleEncoder_t *enc, U8 value) {
+   if ((enc->literalPtr != 0) && (commandBuffer[enc->literalPtr] < RLE_MAX_LITERAL-1)) {
+      commandBuffer[enc->literalPtr]++;
+   }
+   else {
+      enc->literalPtr = enc->outPtr++;
+      commandBuffer[enc->literalPtr] = 0;
+   }
+   commandBuffer[enc->outPtr++] = value;
+}
+
+//! Add the pending run to the encoded data
+//!
+//! Runs shorter than RLE_MIN_RUN are added to the current literal
+//!
+//! @param enc - encoder state
+//!
+static void rleFlushRun(RleEncoder_t *enc) {
+   if (enc->runLength >= RLE_MIN_RUN) {
+      commandBuffer[enc->outPtr++] = 0x80+(enc->runLength-RLE_MIN_RUN);
+      commandBuffer[enc->outPtr++] = enc->runValue;
+      enc->literalPtr = 0;
+   }
+   else {
+      for (; enc->runLength > 0; enc->runLength--)
+         rleAddLiteral(enc, enc->runValue);
+   }
+   enc->runLength = 0;
+}
+
+//! Run-length encode a piece of data, see \ref RLE_Encoding
+//!
+//! @param enc  - encoder state
+//! @param src  - data to encode
+//! @param size - # of bytes (<= RLE_CHUNK_SIZE)
+//!
+//! @note The last run remains pending - use rleFlushRun() after the last piece
+//!
+static void rleEncode(RleEncoder_t *enc, const U8 *src, U8 size) {
+   while (size-- > 0) {
+      if ((enc->runLength == 0) || (*src != enc->runValue) || (enc->runLength >= RLE_MAX_RUN)) {
+         rleFlushRun(enc);
+         enc->runValue = *src;
+      }
+      enc->runLength++;
+      src++;
+   }
+}
+
+//! Read target memory returning run-length encoded data
+//!
+//! The memory is read using the target's CMD_USBDM_READ_MEM in pieces that are
+//! encoded until the response is full or the range is complete.  Runs continue
+//! across pieces so a single response may cover a large range of erased or
+//! sparse memory (RLE_MAX_RUN bytes per 2 encoded bytes, ~8 KB on JMxx).
+//!
+//! @note
+//!  commandBuffer                           \n
+//!  - [2]    = element size/memory space    \n
+//!  - [3]    = unused                       \n
+//!  - [4..7] = address                      \n
+//!  - [8..9] = # of bytes (1..65535, address & # of bytes must be multiples of element size)
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..2] = # of bytes of target memory encoded (may be less than requested) \n
+//!  - [3..N] = encoded data, see \ref RLE_Encoding
+//!
+U8 f_CMD_READ_MEM_RLE(void) {
+FunctionPtr  readMem     = getTargetFunction(CMD_USBDM_READ_MEM);
+U8           elementSize = commandBuffer[2];
+U32          address     = *(U32*)(commandBuffer+4);
+U16          count       = *(U16*)(commandBuffer+8);
+U16          done        = 0;
+RleEncoder_t enc;
+U8           chunk;
+U8           rc;
+
+   if (readMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   if (count == 0)
+      return BDM_RC_ILLEGAL_PARAMS;
+   rc = checkMemoryRange(elementSize, address, count);
+   if (rc != BDM_RC_OK)
+      return rc;
+
+   enc.outPtr     = RLE_OUTPUT_START;
+   enc.literalPtr = 0;
+   enc.runLength  = 0;
+
+   // Stop when the next piece may not fit
+   while ((done < count) && (enc.outPtr+RLE_PIECE_MAX <= MAX_COMMAND_SIZE)) {
+      chunk = RLE_CHUNK_SIZE;
+      if (count-done < chunk)
+         chunk = (U8)(count-done);
+      rc = readTargetMemory(readMem, elementSize, address, chunk);
+      if (rc != BDM_RC_OK)
+         return rc;
+      rleEncode(&enc, commandBuffer+1, chunk);
+      address += chunk;
+      done    += chunk;
+      rc = chunkProgress(done);
+      if (rc != BDM_RC_OK)
+         return rc;
+   }
+   rleFlushRun(&enc);
+   // Move encoded data after count
+   (void)memmove(commandBuffer+3, commandBuffer+RLE_OUTPUT_START, enc.outPtr-RLE_OUTPUT_START);
+   *(U16*)(commandBuffer+1) = done;
+   returnSize = 3+(enc.outPtr-RLE_OUTPUT_START);
+   return BDM_RC_OK;
+}
+
+//! Number of bytes decoded before each write to the target (multiple of 4)
+#define RLE_WINDOW_SIZE (64)
+//! Maximum size of encoded data for CMD_USBDM_WRITE_MEM_RLE
+#define RLE_MAX_ENCODED (MAX_COMMAND_SIZE-10-RLE_WINDOW_SIZE)
+
+//! Check run-length encoded data and calculate its size when decoded
+//!
+//! @param encPtr - start of encoded data in commandBuffer (data ends at MAX_COMMAND_SIZE)
+//!
+//! @return # of bytes after decoding, 0 => encoded data is malformed
+//!
+static U16 rleDecodedSize(U8 encPtr) {
+U16 total = 0;
+U8  control;
+U8  length;
+
+   while (encPtr < MAX_COMMAND_SIZE) {
+      control = commandBuffer[encPtr++];
+      if (control < 0x80) {
+         // Literal bytes
+         length = control+1;
+         if (length > MAX_COMMAND_SIZE-encPtr)
+            return 0;
+         encPtr += length;
+      }
+      else {
+         // Repeated byte
+         if (encPtr >= MAX_COMMAND_SIZE)
+            return 0;
+         length = control-0x80+RLE_MIN_RUN;
+         encPtr++;
+      }
+      total += length;
+   }
+   return total;
+}
+
+//! Write run-length encoded data to target memory
+//!
+//! The data is decoded into a small window in commandBuffer which is written
+//! using the target's CMD_USBDM_WRITE_MEM each time it fills.
+//! The complete encoded data is checked before anything is written.
+//!
+//! @note
+//!  commandBuffer                           \n
+//!  - [0]     = size of command             \n
+//!  - [2]     = element size/memory space   \n
+//!  - [3]     = unused                      \n
+//!  - [4..7]  = address                     \n
+//!  - [8..9]  = # of bytes after decoding   \n
+//!  - [10..N] = encoded data (up to RLE_MAX_ENCODED bytes), see \ref RLE_Encoding
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..4] = # of bytes written
+//!
+U8 f_CMD_WRITE_MEM_RLE(void) {
+FunctionPtr writeMem    = getTargetFunction(CMD_USBDM_WRITE_MEM);
+U8          elementSize = commandBuffer[2];
+U32         address     = *(U32*)(commandBuffer+4);
+U16         count       = *(U16*)(commandBuffer+8);
+U32         done        = 0;
+U8          encPtr;      // Next encoded byte (at end of buffer)
+U8          fill = 0;    // # of bytes in window
+U8          control;
+U8          length;
+U8          value = 0;
+U8          rc;
+
+   if (writeMem == f_CMD_ILLEGAL)
+      return BDM_RC_ILLEGAL_COMMAND;
+   if ((commandBuffer[0] <= 10) || (commandBuffer[0]-10 > RLE_MAX_ENCODED))
+      return BDM_RC_ILLEGAL_PARAMS;
+
+   // Move encoded data to end of buffer leaving room for the decode window
+   //
+   //  +------------+--------------------+-------------------+
+   //  | Parameters | Window (decoded)   | Encoded data      |
+   //  +------------+--------------------+-------------------+
+   //
+   encPtr = MAX_COMMAND_SIZE-(commandBuffer[0]-10);
+   (void)memmove(commandBuffer+encPtr, commandBuffer+10, MAX_COMMAND_SIZE-encPtr);
+   // Don't write anything unless all the data is valid
+   if ((count == 0) || (rleDecodedSize(encPtr) != count))
+      return BDM_RC_ILLEGAL_PARAMS;
+   while (encPtr < MAX_COMMAND_SIZE) {
+      control = commandBuffer[encPtr++];
+      if (control < 0x80) {
+         // Literal bytes
+         length = control+1;
+      }
+      else {
+         // Repeated byte
+         length = control-0x80+RLE_MIN_RUN;
+         value  = commandBuffer[encPtr++];
+      }
+      while (length-- > 0) {
+         if (control < 0x80)
+            value = commandBuffer[encPtr++];
+         commandBuffer[8+fill++] = value;
+         if (fill == RLE_WINDOW_SIZE) {
+            rc = writeTargetMemory(writeMem, elementSize, address, fill);
+            if (rc != BDM_RC_OK)
+               return rc;
+            address += fill;
+            done    += fill;
+            fill     = 0;
+         }
+      }
+   }
+   if (fill > 0) {
+      rc = writeTargetMemory(writeMem, elementSize, address, fill);
+      if (rc != BDM_RC_OK)
+         return rc;
+      done += fill;
+   }
+   *(U32*)(commandBuffer+1) = done;
+   returnSize = 5;
+   return BDM_RC_OK;
+}
+
+//! Largest response or workspace of the fixed size commands allowed in a batch
+#define BATCH_SMALL_RESULT (16)
+
+//! Worst case use of commandBuffer by a command executed from a batch
+//!
+//! Only commands whose parameters, workspace and results are limited to the
+//! start of commandBuffer are allowed.  Commands that use the end of the
+//! buffer or a full buffer (e.g. CMD_USBDM_CRC_MEM) would overwrite the
+//! remaining commands.
+//!
+//! The results of these commands are no larger than the bytes used.
+//!
+//! @param cmd - command within batch, cmd[0] = size of command
+//!
+//! @return # of bytes of commandBuffer that may be used, 0 => not allowed in a batch
+//!
+static U8 batchBufferUse(const U8 *cmd) {
+U8 size  = cmd[0];
+U8 count = cmd[3];
+
+   switch (cmd[1]&0x7F) {
+      case CMD_USBDM_SET_TARGET:
+      case CMD_USBDM_SET_VDD:
+      case CMD_USBDM_GET_BDM_STATUS:
+      case CMD_USBDM_GET_CAPABILITIES:
+      case CMD_USBDM_SET_OPTIONS:
+      case CMD_USBDM_CONTROL_PINS:
+      case CMD_USBDM_CONNECT:
+      case CMD_USBDM_SET_SPEED:
+      case CMD_USBDM_GET_SPEED:
+      case CMD_USBDM_READ_STATUS_REG:
+      case CMD_USBDM_WRITE_CONTROL_REG:
+      case CMD_USBDM_TARGET_RESET:
+      case CMD_USBDM_TARGET_STEP:
+      case CMD_USBDM_TARGET_GO:
+      case CMD_USBDM_TARGET_HALT:
+      case CMD_USBDM_WRITE_REG:
+      case CMD_USBDM_READ_REG:
+      case CMD_USBDM_WRITE_CREG:
+      case CMD_USBDM_READ_CREG:
+      case CMD_USBDM_WRITE_DREG:
+      case CMD_USBDM_READ_DREG:
+      case CMD_USBDM_SET_VPP:
+      case CMD_USBDM_POLL_MEM:
+      case CMD_USBDM_MODIFY_MEM:
+      case CMD_USBDM_SET_READ_CACHE:
+         return (size > BATCH_SMALL_RESULT)?size:BATCH_SMALL_RESULT;
+      case CMD_USBDM_READ_MEM:
+         // Parameters [0..7] then result [0..count]
+         if (size < 8)
+            return 0;
+         return (count >= 8)?count+1:8;
+      case CMD_USBDM_WRITE_MEM:
+         // Data must be within the command
+         if ((size < 8) || (count > size-8))
+            return 0;
+         return size;
+      default:
+         return 0;
+   }
+}
+
+//! Execute a list of commands
+//!
+//! Each command is executed by commandExec() as if received individually.
+//!
+//! @note
+//!  commandBuffer                                    \n
+//!  - [2]    = options see \ref BatchOptions_t       \n
+//!  - [3..N] = commands, each formatted as usual     \n
+//!    - [0]    = size of command (including this byte)  \n
+//!    - [1]    = command                             \n
+//!    - [2..]  = parameters
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!    != \ref BDM_RC_OK => error            \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..N] = results, one entry per command executed \n
+//!    - [0]    = size of response (n)       \n
+//!    - [1..n] = response (status + results) as usual
+//!
+//! @note Only commands that use the start of commandBuffer are allowed
+//!       (see batchBufferUse()) and their results must fit in commandBuffer.
+//!       All commands are checked before any is executed.
+//!
+U8 f_CMD_EXECUTE_BATCH(void) {
+U8 options  = commandBuffer[2];
+U8 cmdStart;                     // Start of remaining commands
+U8 resStart = MAX_COMMAND_SIZE;  // Start of results (end of commands)
+U8 size;
+U8 use;
+U8 command;
+U16 resWorst;                    // Worst case space taken by results so far
+
+   if ((commandBuffer[0] < 3) || (commandBuffer[0] > MAX_COMMAND_SIZE))
+      return BDM_RC_ILLEGAL_PARAMS;
+   cmdStart = MAX_COMMAND_SIZE-(commandBuffer[0]-3);
+
+   // Move commands to end of buffer.  Results are then kept after the
+   // commands and the start of the buffer is used to execute each command
+   //
+   //  +----------+---------------------+---------+
+   //  | Exec     | Remaining commands  | Results |
+   //  +----------+---------------------+---------+
+   //
+   (void)memmove(commandBuffer+cmdStart, commandBuffer+3, resStart-cmdStart);
+
+   // Check every command before executing any of them.  The room available
+   // to a command shrinks as results are added - assume each result is as
+   // large as the buffer the command may use.
+   resWorst = 0;
+   for (command=cmdStart; command<resStart; command+=size) {
+      size = commandBuffer[command];
+      if ((size < 2) || (size > resStart-command))
+         return BDM_RC_ILLEGAL_PARAMS;
+      use = batchBufferUse(commandBuffer+command);
+      if ((use == 0) || (2*use+1+resWorst > command+size))
+         return BDM_RC_ILLEGAL_PARAMS;
+      resWorst += use+1;
+   }
+   while (cmdStart < resStart) {
+      size    = commandBuffer[cmdStart];
+      command = commandBuffer[cmdStart+1]&0x7F;
+      // Move command to start of buffer
+      (void)memmove(commandBuffer, commandBuffer+cmdStart, size);
+      commandBuffer[1] = command;
+      cmdStart += size;
+      size = commandExec();
+      // Move remaining commands & results down to make room for new result
+      (void)memmove(commandBuffer+cmdStart-(size+1), commandBuffer+cmdStart, MAX_COMMAND_SIZE-cmdStart);
+      cmdStart -= size+1;
+      resStart -= size+1;
+      // Append result
+      commandBuffer[MAX_COMMAND_SIZE-(size+1)] = size;
+      (void)memcpy(commandBuffer+MAX_COMMAND_SIZE-size, commandBuffer, size);
+      if (((commandBuffer[0] != BDM_RC_OK) && (options&BATCH_STOP_ON_ERROR)) || commandAbort)
+         break;
+   }
+   // Move results to start of buffer
+   size = MAX_COMMAND_SIZE-resStart;
+   (void)memmove(commandBuffer+1, commandBuffer+resStart, size);
+   returnSize = size+1;
+   return BDM_RC_OK;
+}
+
+#if READ_CACHE
+//==========================================================================
+// Read cache
+//
+// Results of CMD_USBDM_READ_MEM & CMD_USBDM_READ_REG (core registers) are
+// kept while the target is known to be halted so that repeated reads (e.g. a
+// debugger refreshing its views) are answered without accessing the target.
+// CMD_USBDM_READ_CREG is not cached as on some targets (e.g. ARM-SWD AP
+// registers) the registers are volatile or reading them has side effects.
+//
+// The target is known to be halted after a successful CMD_USBDM_TARGET_HALT or
+// CMD_USBDM_TARGET_STEP or when the host says so (READ_CACHE_HALTED).
+// Any command that may change the target flushes the cache and anything that
+// may resume the target (GO, RESET, errors, reset detected etc.) also disables
+// it until the target is again known to be halted.
+//
+// The cache is disabled by default since memory-mapped peripherals may change
+// while the CPU is halted.  The host enables it by CMD_USBDM_SET_READ_CACHE.
+//==========================================================================
+
+#define READ_CACHE_BLOCKS     (3)   //!< Number of memory blocks cached
+#define READ_CACHE_BLOCK_SIZE (64)  //!< Largest CMD_USBDM_READ_MEM that is cached
+#define READ_CACHE_REGS       (8)   //!< Number of register values cached
+
+//! Cached memory block
+typedef struct {
+   U32 address;                        //!< Target address
+   U8  elementSize;                    //!< Element size/memory space
+   U8  count;                          //!< Size of block (0 => unused)
+   U8  age;                            //!< Lookups since last used (LRU)
+   U8  data[READ_CACHE_BLOCK_SIZE];    //!< Block contents
+} ReadCacheBlock_t;
+
+//! Cached register value
+typedef struct {
+   U8  command;                        //!< CMD_USBDM_READ_REG (0 => unused)
+   U8  size;                           //!< Size of value
+   U16 regNo;                          //!< Register number
+   U8  value[4];                       //!< Register value as returned by command
+} ReadCacheReg_t;
+
+static ReadCacheBlock_t cacheBlocks[READ_CACHE_BLOCKS];
+static ReadCacheReg_t   cacheRegs[READ_CACHE_REGS];
+static U8  cacheEnabled;        //!< Cache enabled by host
+static U8  targetHalted;        //!< Target is known to be halted
+static U8  nextCacheReg;        //!< Next register entry to replace (round-robin)
+static U8  cachePending;        //!< Command whose result is to be cached (0 => none)
+static U32 pendingAddress;      //!< Address/register number of pending result
+static U8  pendingElementSize;  //!< Element size of pending result
+static U8  pendingCount;        //!< Size of pending result
+static U16 cacheHits;           //!< Statistics for CMD_USBDM_SET_READ_CACHE
+static U16 cacheMisses;
+
+//! Discard all cached values
+//!
+//! @note Called directly when the target is (re)connected e.g. speed re-measured
+//!
+void readCacheFlush(void) {
+U8 index;
+
+   for (index=0; index<READ_CACHE_BLOCKS; index++)
+      cacheBlocks[index].count = 0;
+   for (index=0; index<READ_CACHE_REGS; index++)
+      cacheRegs[index].command = 0;
+}
+
+//! Discard all cached values and stop caching until the target is again known to be halted
+//!
+//! @note Called directly wherever the target may be reset or (re)connected
+//!       rather than relying on readCacheUpdate() classifying the command
+//!
+void readCacheInvalidate(void) {
+   targetHalted = FALSE;
+   readCacheFlush();
+}
+
+//! Look up the current command in the read cache
+//!
+//! @param command - command about to be executed
+//!
+//! @return TRUE  => result has been placed in commandBuffer[1..N] & returnSize set \n
+//!         FALSE => command must be executed (result may be cached by readCacheUpdate())
+//!
+static U8 readCacheLookup(U8 command) {
+ReadCacheBlock_t *block;
+ReadCacheBlock_t *hit = NULL;
+ReadCacheReg_t   *reg;
+
+   cachePending = 0;
+   if (!cacheEnabled || !targetHalted)
+      return FALSE;
+   if ((cable_status.reset == RESET_DETECTED)
+#if (HW_CAPABILITY&CAP_VDDSENSE)
+       || (cable_status.power == BDM_TARGET_VDD_NONE) || (cable_status.power == BDM_TARGET_VDD_ERR)
+#endif
+      ) {
+      // Target has been reset or lost power
+      readCacheInvalidate();
+      return FALSE;
+   }
+   switch (command) {
+      case CMD_USBDM_READ_MEM:
+         if ((commandBuffer[3] == 0) || (commandBuffer[3] > READ_CACHE_BLOCK_SIZE))
+            return FALSE;
+         pendingElementSize = commandBuffer[2];
+         pendingCount       = commandBuffer[3];
+         pendingAddress     = *(U32*)(commandBuffer+4);
+         for (block=cacheBlocks; block<cacheBlocks+READ_CACHE_BLOCKS; block++) {
+            if (block->age < 0xFF)
+               block->age++;
+            if ((block->count == pendingCount) && (block->elementSize == pendingElementSize) &&
+                (block->address == pendingAddress))
+               hit = block;
+         }
+         if (hit != NULL) {
+            hit->age = 0;
+            (void)memcpy(commandBuffer+1, hit->data, hit->count);
+            returnSize = hit->count+1;
+            cacheHits++;
+            return TRUE;
+         }
+         break;
+      case CMD_USBDM_READ_REG:
+         pendingAddress = *(U16*)(commandBuffer+2);
+         for (reg=cacheRegs; reg<cacheRegs+READ_CACHE_REGS; reg++) {
+            if ((reg->command == command) && (reg->regNo == (U16)pendingAddress)) {
+               (void)memcpy(commandBuffer+1, reg->value, reg->size);
+               returnSize = reg->size+1;
+               cacheHits++;
+               return TRUE;
+            }
+         }
+         break;
+      default:
+         return FALSE;
+   }
+   cachePending = command;
+   cacheMisses++;
+   return FALSE;
+}
+
+//! Save result of a read that missed the cache
+//!
+//! @param command - command just executed
+//!
+static void readCacheStore(U8 command) {
+ReadCacheBlock_t *block;
+ReadCacheBlock_t *victim = cacheBlocks;
+ReadCacheReg_t   *reg;
+
+   if (command == CMD_USBDM_READ_MEM) {
+      if (returnSize-1 != pendingCount)
+         return;
+      // Replace unused or least recently used block
+      for (block=cacheBlocks; block<cacheBlocks+READ_CACHE_BLOCKS; block++) {
+         if (block->count == 0) {
+            victim = block;
+            break;
+         }
+         if (block->age > victim->age)
+            victim = block;
+      }
+      victim->address     = pendingAddress;
+      victim->elementSize = pendingElementSize;
+      victim->count       = pendingCount;
+      victim->age         = 0;
+      (void)memcpy(victim->data, commandBuffer+1, pendingCount);
+   }
+   else {
+      if ((returnSize <= 1) || (returnSize > 1+sizeof(reg->value)))
+         return;
+      reg = cacheRegs+nextCacheReg;
+      if (++nextCacheReg >= READ_CACHE_REGS)
+         nextCacheReg = 0;
+      reg->command = command;
+      reg->regNo   = (U16)pendingAddress;
+      reg->size    = returnSize-1;
+      (void)memcpy(reg->value, commandBuffer+1, reg->size);
+   }
+}
+
+//! Update read cache after a command has been executed
+//!
+//! @param command - command just executed
+//!
+static void readCacheUpdate(U8 command) {
+U8 pending = cachePending;
+
+   cachePending = 0;
+   if (commandStatus != BDM_RC_OK) {
+      // Target state unknown
+      readCacheInvalidate();
+      return;
+   }
+   switch (command) {
+      case CMD_USBDM_READ_MEM:
+      case CMD_USBDM_READ_REG:
+         // Not if the target was reset by the command
+         if ((pending == command) && targetHalted)
+            readCacheStore(command);
+         break;
+      // Commands that do not change the target
+      // Batched commands are checked individually
+      case CMD_USBDM_READ_CREG:
+      case CMD_USBDM_GET_COMMAND_RESPONSE:
+      case CMD_USBDM_GET_BDM_STATUS:
+      case CMD_USBDM_GET_CAPABILITIES:
+      case CMD_USBDM_SET_OPTIONS:
+      case CMD_USBDM_GET_SPEED:
+      case CMD_USBDM_READ_STATUS_REG:
+      case CMD_USBDM_READ_DREG:
+      case CMD_USBDM_READ_MEM_STREAM:
+      case CMD_USBDM_EXECUTE_BATCH:
+      case CMD_USBDM_CRC_MEM:
+      case CMD_USBDM_VERIFY_MEM:
+      case CMD_USBDM_READ_MEM_GATHER:
+      case CMD_USBDM_POLL_MEM:
+      case CMD_USBDM_HASH_MEM:
+      case CMD_USBDM_READ_MEM_RLE:
+      case CMD_USBDM_SET_READ_CACHE:
+         break;
+      // Target is left halted
+      case CMD_USBDM_TARGET_HALT:
+      case CMD_USBDM_TARGET_STEP:
+         readCacheFlush();
+         targetHalted = TRUE;
+         break;
+      // Target changed but still halted
+      case CMD_USBDM_WRITE_REG:
+      case CMD_USBDM_WRITE_CREG:
+      case CMD_USBDM_WRITE_MEM:
+      case CMD_USBDM_FILL_MEM:
+      case CMD_USBDM_MODIFY_MEM:
+      case CMD_USBDM_WRITE_MEM_RLE:
+         readCacheFlush();
+#if (TARGET_CAPABILITY&CAP_ARM_SWD)
+         if (cable_status.target_type == T_ARM_SWD) {
+            // Memory writes may resume the target (DHCSR)
+            targetHalted = FALSE;
+         }
+#endif
+         break;
+      // Anything else may resume or reset the target
+      default:
+         readCacheInvalidate();
+         break;
+   }
+}
+
+//! Control probe-side read cache
+//!
+//! @note
+//!  commandBuffer                           \n
+//!  - [2] = options see \ref ReadCacheOptions_t
+//!
+//! @return
+//!    == \ref BDM_RC_OK => success          \n
+//!                                          \n
+//!  commandBuffer                           \n
+//!  - [1..2] = # of reads satisfied from the cache \n
+//!  - [3..4] = # of reads not in the cache  \n
+//!
+//! @note The cache is flushed and the statistics are cleared
+//!
+U8 f_CMD_SET_READ_CACHE(void) {
+U8 options = commandBuffer[2];
+
+   readCacheFlush();
+   cacheEnabled = (options&READ_CACHE_ENABLE) != 0;
+   if (options&READ_CACHE_HALTED)
+      targetHalted = TRUE;
+   *(U16*)(commandBuffer+1) = cacheHits;
+   *(U16*)(commandBuffer+3) = cacheMisses;
+   cacheHits   = 0;
+   cacheMisses = 0;
+   returnSize  = 5;
+   return BDM_RC_OK;
+}
+#else
+//! No read cache - nothing to discard
+//!
+void readCacheFlush(void) {
+}
+
+//! No read cache - nothing to discard
+//!
+void readCacheInvalidate(void) {
+}
+#endif // READ_CACHE
+
+//! Determines if a command may change the target's BDM speed
+//! i.e. the target runs code, is reset, is power cycled or has its pins driven,
+//! or the command failed in a way that suggests the speed is wrong.
+//!
+//! Memory & register writes (e.g. clock trim) are not included - a changed
+//! speed is then found by the periodic re-measurement (\ref CONNECTION_VALIDms).
+//!
+//! @param command - command to check
+//! @param status  - result of the command
+//!
+//! @return TRUE if the speed must be re-measured before the next command
+//!
+static U8 invalidatesConnection(U8 command, U8 status) {
+   switch (status) {
+      case BDM_RC_OK:
+         break;
+      case BDM_RC_ILLEGAL_PARAMS:
+      case BDM_RC_ILLEGAL_COMMAND:
+         return FALSE;  // Rejected without any target access
+      default:
+         return TRUE;   // Communication error, timeout etc.
+   }
+   switch (command) {
+      case CMD_USBDM_SET_TARGET:
+      case CMD_USBDM_SET_VDD:
+      case CMD_USBDM_CONTROL_PINS:
+      case CMD_USBDM_CONNECT:
+      case CMD_USBDM_SET_SPEED:
+      case CMD_USBDM_WRITE_CONTROL_REG:
+      case CMD_USBDM_TARGET_RESET:
+      case CMD_USBDM_TARGET_STEP:
+      case CMD_USBDM_TARGET_GO:
+         return TRUE;
+      default:
+         return FALSE;
+   }
+}
+
+//!  Processes all commands received over USB
+//!
+//!  The command is expected to be in \ref commandBuffer[1..N]
+//!
+//!  @return Number of bytes left in commandBuffer to be sent back as response.\n
+//!         commandBuffer[0]    = result code, BDM_RC_OK => success, else failure error code\n
+//!         commandBuffer[1..N] = command results
+//!
+U8 commandExec(void) {
+BDMCommands command    = commandBuffer[1];  // Command is 1st byte
+FunctionPtr commandPtr = f_CMD_ILLEGAL;     // Default to illegal command
+#if (DEBUG&COMMAND_TIMING)
+U16 startTicks         = TPMCNT;            // Time command
+U16 startFrame         = usbFrameCount;
+#endif
+
+#if (DEBUG&COMMAND_BUSY)
+   DEBUG_PIN_DDR = 1;
+   DEBUG_PIN     = 1;
+#endif
+
+   // Check if modeless command
+   if ((U8)command < sizeof(commonFunctionPtrs)/sizeof(FunctionPtr)) {
+      // Modeless command
+      commandPtr = commonFunctionPtrs[(U8)command];
+   }
+   else if ((U8)command >= extendedFunctionPointers.firstCommand) {
+      // Extended command
+      U8 commandIndex = (U8)command - extendedFunctionPointers.firstCommand;
+      if (commandIndex < extendedFunctionPointers.size)
+         commandPtr = extendedFunctionPointers.functions[commandIndex];
+   }
+   else {
+      // Target specific command
+      commandPtr = getTargetFunction((U8)command);
+   }
+   // Execute the command
+   // Note: returnSize & commandBuffer may be updated by command
+   //       returnSize has a default value of 1
+   //       commandStatus has a default value of BDM_RC_OK
+   //       On error, returnSize is forced to 1 unless the response has been sent (0)
+   returnSize       = 1;
+   commandStatus = BDM_RC_OK;
+   if (targetResetSeen) {
+      // Target has been reset since the last command
+      targetResetSeen = FALSE;
+      connectionValid = FALSE;                     // Target speed may have changed
+#if READ_CACHE
+      readCacheInvalidate();                       // Target is no longer halted
+#endif
+   }
+#if READ_CACHE
+   if (readCacheLookup((U8)command)) {
+      // Result taken from cache - target not accessed
+      commandBuffer[0] = commandStatus;
+   }
+   else
+#endif
+   {
+      if ((command >= CMD_USBDM_READ_STATUS_REG) && (command != CMD_USBDM_EXECUTE_BATCH)) {
+         // Check if re-connect needed before most commands (always)
+         // Batched commands are checked individually
+         commandStatus = optionalReconnect(AUTOCONNECT_ALWAYS);
+      }
+      if (commandStatus == BDM_RC_OK) {
+         commandStatus = commandPtr();      // Execute command & update command status
+         commandBuffer[0] = commandStatus;  // return command status
+      }
+   }
+#if READ_CACHE
+   readCacheUpdate((U8)command);
+#endif
+   if (invalidatesConnection((U8)command, commandStatus)) {
+      // Re-measure speed before next command (if auto re-connecting)
+      connectionValid = FALSE;
+   }
+   if (commandStatus != BDM_RC_OK) {
+      if (returnSize != 0)
+         returnSize = 1;  // Return a single byte error code (unless already sent e.g. by stream)
+      // Do any common cleanup here
+#if (TARGET_CAPABILITY&CAP_ARM_SWD)
+   if (cable_status.target_type == T_ARM_SWD) {
+      // Clear stick bits since already reporting error
+	   (void)swd_clearStickyError();
+   }
+#endif
+#if (TARGET_CAPABILITY&CAP_CFVx)
+      if (cable_status.target_type == T_CFVx) {
+         (void)bdmcf_complete_chk_rx(); //  Send at least 2 NOPs to purge the BDM
+         (void)bdmcf_complete_chk_rx(); //  of the offending command
+      }
+#endif
+   }
+#if (DEBUG&COMMAND_BUSY)
+   DEBUG_PIN_DDR = 1;
+   DEBUG_PIN     = 0;
+#endif
+#if (DEBUG&COMMAND_TIMING)
+   recordCommandTiming((U8)command, elapsedTicks(startTicks, startFrame));
+#endif
+   return returnSize;
+}
+
+#if (VERSION_HW!=(HW_JB+TARGET_HARDWARE))
+void commandLoop(void) {
+U8 size;
+#if (DEBUG&COMMAND_TRACE)
+CommandTraceRecord_t traceRecord;
+#endif
+// Define to discard commands at random for command retry testing
+//#define TESTDISCARD
+
+#ifdef TESTDISCARD
+   static U8 doneErrorFlag = FALSE;
+   RTCSC = (2<<RTCSC_RTCLKS_BITNUM)|(8<<RTCSC_RTCPS_BITNUM);
+   RTCMOD = 0xFF;
+#endif
+   
+#if 1
+   for(;;) {
+      (void)receiveUSBCommand( MAX_COMMAND_SIZE, commandBuffer );
+#ifdef TESTDISCARD
+      if (RTCCNT == 128) {
+    	  if (!doneErrorFlag) {
+    	     doneErrorFlag = TRUE;
+    	     continue;
+    	  }
+      }
+      else
+    	  doneErrorFlag = FALSE;
+#endif
+#if (DEBUG&COMMAND_TRACE)
+      traceRecord.command     = commandBuffer[1];
+      traceRecord.commandSize = commandBuffer[0];
+      traceRecord.frameCount  = usbFrameCount;
+      traceRecord.timerTicks  = TPMCNT;
+#endif
+      commandToggle = commandBuffer[1] & 0x80;
+      commandBuffer[1] &= 0x7F;
+      // Start new progress record
+      commandProgress.command   = commandBuffer[1];
+      commandProgress.opcode    = 0;
+      setCommandProgress(0);
+      commandProgress.startTime = usbFrameCount;
+      commandAbort              = FALSE;
+      size = commandExec();
+      commandBuffer[0] |= commandToggle;
+#if (DEBUG&COMMAND_TRACE)
+      traceRecord.status       = commandBuffer[0];
+      traceRecord.responseSize = size;
+#endif
+      if (size > 0) {
+         // Not already sent e.g. by stream
+         sendUSBResponse( size, commandBuffer );
+      }
+#if (DEBUG&COMMAND_TRACE)
+      addCommandTrace(&traceRecord);
+#endif
+   }
+#elif 0
+   for(;;) {
+      enableInterrupts();
+      (void)receiveUSBCommand( MAX_COMMAND_SIZE, commandBuffer );
+      if (commandBuffer[1] == CMD_USBDM_GET_CAPABILITIES)
+    	  commandToggle = 0;
+      commandBuffer[1] &= 0x7F;
+      size = commandExec();
+      if (commandToggle)
+    	 commandBuffer[0] |= 0x80;
+      else
+     	 commandBuffer[0] &= ~0x80;
+      commandToggle += 0x80;
+      sendUSBResponse( size, commandBuffer );
+   }
+#else
+   for(;;) {
+      enableInterrupts();
+      (void)receiveUSBCommand( MAX_COMMAND_SIZE, commandBuffer );
+      size = commandExec();
+      sendUSBResponse( size, commandBuffer );
+   }
+#endif
+}
+#endif
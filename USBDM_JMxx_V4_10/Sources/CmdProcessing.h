@@ -1,23 +1,56 @@
-/*! \file
-    \brief Main command procedure for executing BDM commands received over the USB.
-*/    
-#ifndef _CMDPROCESSING_H_
-#define _CMDPROCESSING_H_
-
-extern U8 commandExec(void);
-
-extern void commandLoop(void);
-extern U8   compatibleCommandExec(void);
-extern U8   optionalReconnect(U8 when);
-
-extern U8  commandBuffer[]; // Buffer for USB command in, result out
-
-#ifdef __HC08__
-#pragma DATA_SEG __SHORT_SEG Z_PAGE
-#endif // __HC08__
-extern U8               returnSize;       // Size of command return result
-extern BDM_Option_t     bdm_option;       // Options for cable operation
-extern CableStatus_t    cable_status;     // Status of the BDM interface
-#pragma DATA_SEG DEFAULT
-
-#endif;
+/*! \file
+    \brief Main command procedure for executing BDM commands received over the USB.
+*/    
+#ifndef _CMDPROCESSING_H_
+#define _CMDPROCESSING_H_
+
+extern U8 commandExec(void);
+
+extern void commandLoop(void);
+extern U8   compatibleCommandExec(void);
+extern U8   optionalReconnect(U8 when);
+extern U16  makeStatusWord(void);
+extern U16  peekStatusWord(void);
+extern void commandIdle(void);
+
+//! Progress of the command currently executing (reported by CMD_USBDM_GET_PROGRESS)
+//!
+//! @note Updated by the command loop and read from the USB interrupt so values are approximate.
+//!       done is multi-byte so is only changed through setCommandProgress()
+typedef struct {
+   U8  command;     //!< Command being executed
+   U8  opcode;      //!< Sub-operation e.g. JTAG sequence opcode
+   U32 done;        //!< Number of bytes completed
+   U16 startTime;   //!< USB frame count (ms) when command was started
+} CommandProgress_t;
+
+extern volatile CommandProgress_t commandProgress;
+extern volatile U8                commandAbort;    // Set by CMD_USBDM_ABORT
+
+extern void setCommandProgress(U32 done);
+extern void readCacheFlush(void);
+extern void readCacheInvalidate(void);
+
+//! Record progress of a long operation & check for abort request
+//!
+//! @param rc - return code variable, set to BDM_RC_ABORTED if the host has requested an abort
+//!             (an existing error is not replaced)
+//! @param n  - number of bytes completed
+//!
+#define UPDATE_PROGRESS(rc, n) {                  \
+   setCommandProgress(commandProgress.done+(n));  \
+   if (commandAbort && ((rc) == BDM_RC_OK))       \
+      (rc) = BDM_RC_ABORTED;                      \
+   }
+
+extern U8  commandBuffer[]; // Buffer for USB command in, result out
+
+#ifdef __HC08__
+#pragma DATA_SEG __SHORT_SEG Z_PAGE
+#endif // __HC08__
+extern U8               returnSize;       // Size of command return result
+extern BDM_Option_t     bdm_option;       // Options for cable operation
+extern CableStatus_t    cable_status;     // Status of the BDM interface
+#pragma DATA_SEG DEFAULT
+
+#endif // _CMDPROCESSING_H_
@@ -1,15 +1,29 @@
-#ifndef _USB_H_
-#define _USB_H_
-
-#include "Common.h"
-
-extern void initUSB(void);
-
-extern void receiveUSBCommand( U8 size, U8 *buffer);
-extern void sendUSBResponse( U8 size, const U8 *buffer);
-
-void USBInterruptHandler( void );
-
-void usbPutChar(char ch);
-void setBDMBusy(void);
-#endif  // _USB_H_
+#ifndef _USB_H_
+#define _USB_H_
+
+#include "Common.h"
+
+extern void initUSB(void);
+
+extern void receiveUSBCommand( U8 size, U8 *buffer);
+extern void sendUSBResponse( U8 size, const U8 *buffer);
+
+//! Size of each packet in a streamed IN transfer (= EP2 packet size)
+#define USB_STREAM_PACKET_SIZE (64)
+//! Maximum number of packets in the stream ring buffer
+#define USB_STREAM_MAX_SLOTS   (4)
+
+extern void startUSBStream(U8 *ringBuffer, U8 numSlots);
+extern void putUSBStream( U8 size, const U8 *buffer);
+extern void endUSBStream(void);
+
+extern volatile U16 usbFrameCount;  // Incremented on each USB SOF (~1 ms)
+
+void USBInterruptHandler( void );
+
+U8   saveAndDisableInterrupts(void);
+void setInterrupts(U8 mask);
+
+void usbPutChar(char ch);
+void setBDMBusy(void);
+#endif  // _USB_H_
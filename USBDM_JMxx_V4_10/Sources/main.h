@@ -1,4 +1,4 @@
-#ifndef _MAIN_H_
-#define _MAIN_H_
-
-#endif
+#ifndef _MAIN_H_
+#define _MAIN_H_
+
+#endif
@@ -1,18 +1,23 @@
-/*
- * stdint.h
- *
- *  Created on: 11/09/2011
- *      Author: podonoghue
- */
-
-#ifndef STDINT_H_
-#define STDINT_H_
-
-typedef unsigned char  uint8_t;
-typedef unsigned int   uint16_t;
-typedef unsigned long  uint32_t;
-typedef signed   char  int8_t;
-typedef signed   int   int16_t;
-typedef signed   long  int32_t;
-
-#endif /* STDINT_H_ */
+/*
+ * stdint.h
+ *
+ *  Created on: 11/09/2011
+ *      Author: podonoghue
+ */
+
+#ifndef STDINT_H_
+#define STDINT_H_
+
+#if defined(__HC08__) || defined(__HC12__)
+typedef unsigned char  uint8_t;
+typedef unsigned int   uint16_t;
+typedef unsigned long  uint32_t;
+typedef signed   char  int8_t;
+typedef signed   int   int16_t;
+typedef signed   long  int32_t;
+#else
+// Host-native build - int/long are wider than on the HCS08
+#include <stdint.h>
+#endif
+
+#endif /* STDINT_H_ */